@@ -0,0 +1,84 @@
+/***************************************************************************
+  coordinatetransformcache.cpp - CoordinateTransformCache
+
+ ---------------------
+ begin                : October 2026
+ copyright            : (C) 2026 by QField contributors
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+#include <QMutexLocker>
+
+#include <qgsproject.h>
+
+#include "coordinatetransformcache.h"
+
+
+static QString crsKey( const QgsCoordinateReferenceSystem &crs )
+{
+  return crs.authid().isEmpty() ? crs.toWkt() : crs.authid();
+}
+
+static uint contextHash( const QgsCoordinateTransformContext &context )
+{
+  uint hash = 0;
+  const QMap<QPair<QString, QString>, QString> operations = context.coordinateOperations();
+  for ( auto it = operations.constBegin(); it != operations.constEnd(); ++it )
+    hash = 31 * hash + ( qHash( it.key() ) ^ qHash( it.value() ) );
+  return hash;
+}
+
+CoordinateTransformCache *CoordinateTransformCache::instance()
+{
+  static CoordinateTransformCache *sCache = []
+  {
+    CoordinateTransformCache *cache = new CoordinateTransformCache;
+    QObject::connect( QgsProject::instance(), &QgsProject::transformContextChanged, QgsProject::instance(), [cache] { cache->clear(); } );
+    return cache;
+  }();
+  return sCache;
+}
+
+QgsCoordinateTransform CoordinateTransformCache::transform( const QgsCoordinateReferenceSystem &source, const QgsCoordinateReferenceSystem &destination,
+    const QgsCoordinateTransformContext &context )
+{
+  const CacheKey key { crsKey( source ), crsKey( destination ), contextHash( context ) };
+
+  {
+    QMutexLocker locker( &mMutex );
+    // Contexts with the same hash still have to be equal
+    auto it = mTransforms.constFind( key );
+    if ( it != mTransforms.constEnd() && it->context == context )
+      return it->transform;
+  }
+
+  // Created outside the lock, PROJ may take a while to set up the pipeline
+  const QgsCoordinateTransform transform( source, destination, context );
+
+  QMutexLocker locker( &mMutex );
+  mTransforms.insert( key, Entry { context, transform } );
+
+  return transform;
+}
+
+QgsCoordinateTransform CoordinateTransformCache::transform( const QgsCoordinateReferenceSystem &source, const QgsCoordinateReferenceSystem &destination )
+{
+  return transform( source, destination, QgsProject::instance()->transformContext() );
+}
+
+int CoordinateTransformCache::count() const
+{
+  QMutexLocker locker( &mMutex );
+  return mTransforms.count();
+}
+
+void CoordinateTransformCache::clear()
+{
+  QMutexLocker locker( &mMutex );
+  mTransforms.clear();
+}
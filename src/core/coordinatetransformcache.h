@@ -0,0 +1,94 @@
+/***************************************************************************
+  coordinatetransformcache.h - CoordinateTransformCache
+
+ ---------------------
+ begin                : October 2026
+ copyright            : (C) 2026 by QField contributors
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+#ifndef COORDINATETRANSFORMCACHE_H
+#define COORDINATETRANSFORMCACHE_H
+
+#include <QHash>
+#include <QMutex>
+#include <QString>
+
+#include <qgscoordinatereferencesystem.h>
+#include <qgscoordinatetransform.h>
+#include <qgscoordinatetransformcontext.h>
+
+/**
+ * The CoordinateTransformCache class shares coordinate transforms across the app.
+ *
+ * Creating a QgsCoordinateTransform resolves the datum transforms of the context and sets
+ * up the PROJ pipeline. The cache creates one transform per source CRS, destination CRS and
+ * transform context and hands out copies, which are implicitly shared and may be used from
+ * any thread.
+ *
+ * Transforms for other contexts than the one of the project, e.g. a default context, are
+ * kept next to the ones of the project. All transforms are dropped when the transform
+ * context of the project changes.
+ */
+class CoordinateTransformCache
+{
+  public:
+    CoordinateTransformCache() = default;
+
+    //! Returns the cache shared by the app, it is cleared when the project transform context changes
+    static CoordinateTransformCache *instance();
+
+    /**
+     * Returns a transform from \a source to \a destination using \a context.
+     * The transform is created on the first call for the pair of CRS and the context.
+     */
+    QgsCoordinateTransform transform( const QgsCoordinateReferenceSystem &source, const QgsCoordinateReferenceSystem &destination,
+                                      const QgsCoordinateTransformContext &context );
+
+    /**
+     * Returns a transform from \a source to \a destination using the transform context of the project.
+     */
+    QgsCoordinateTransform transform( const QgsCoordinateReferenceSystem &source, const QgsCoordinateReferenceSystem &destination );
+
+    //! Returns the number of cached transforms
+    int count() const;
+
+    //! Removes all transforms from the cache
+    void clear();
+
+    //! Identifies the transforms between two CRS with a transform context
+    struct CacheKey
+    {
+      QString source;
+      QString destination;
+      //! Hash of the coordinate operations of the context
+      uint context;
+
+      bool operator==( const CacheKey &other ) const
+      {
+        return context == other.context && source == other.source && destination == other.destination;
+      }
+    };
+
+  private:
+    struct Entry
+    {
+      QgsCoordinateTransformContext context;
+      QgsCoordinateTransform transform;
+    };
+
+    QHash<CacheKey, Entry> mTransforms;
+    mutable QMutex mMutex;
+};
+
+inline uint qHash( const CoordinateTransformCache::CacheKey &key, uint seed = 0 )
+{
+  return qHash( key.source, seed ) ^ ( qHash( key.destination, seed ) << 1 ) ^ key.context;
+}
+
+#endif // COORDINATETRANSFORMCACHE_H
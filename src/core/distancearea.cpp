@@ -14,10 +14,27 @@
  *                                                                         *
  ***************************************************************************/
 #include "distancearea.h"
+#include "coordinatetransformcache.h"
 #include "geometry.h"
+#include "geometryutils.h"
 #include "rubberband.h"
 #include "qgsvectorlayer.h"
 #include "qgsproject.h"
+#include "qgsmessagelog.h"
+
+#include <cmath>
+
+/**
+ * Updates the prefix \a sums of \a terms from the term at index \a from on.
+ */
+static void updatePrefixSums( const QVector<double> &terms, QVector<double> &sums, int from )
+{
+  from = qBound( 0, from, std::max( sums.size() - 1, 0 ) );
+  sums.resize( terms.size() + 1 );
+  sums[0] = 0;
+  for ( int i = from; i < terms.size(); ++i )
+    sums[i + 1] = sums[i] + terms.at( i );
+}
 
 DistanceArea::DistanceArea( QObject *parent )
   : QObject( parent )
@@ -38,8 +55,16 @@ void DistanceArea::init()
     mDistanceArea.setEllipsoid( geoNone() );
   }
 
+  if ( mDistanceArea.willUseEllipsoid() )
+  {
+    mEllipsoidDistanceArea.setEllipsoid( mDistanceArea.ellipsoid() );
+    mEllipsoidDistanceArea.setSourceCrs( mDistanceArea.ellipsoidCrs(), mProject->transformContext() );
+  }
+
   emit lengthUnitsChanged();
   emit areaUnitsChanged();
+
+  recompute();
 }
 
 QgsProject *DistanceArea::project() const
@@ -77,9 +102,10 @@ void DistanceArea::setRubberbandModel( RubberbandModel *rubberbandModel )
 
   if ( mRubberbandModel )
   {
-    disconnect( mRubberbandModel, &RubberbandModel::vertexChanged, this, &DistanceArea::lengthChanged );
-    disconnect( mRubberbandModel, &RubberbandModel::vertexChanged, this, &DistanceArea::areaChanged );
-    disconnect( mRubberbandModel, &RubberbandModel::vertexChanged, this, &DistanceArea::segmentLengthChanged );
+    disconnect( mRubberbandModel, &RubberbandModel::vertexChanged, this, &DistanceArea::onVertexChanged );
+    disconnect( mRubberbandModel, &RubberbandModel::verticesInserted, this, &DistanceArea::onVerticesInserted );
+    disconnect( mRubberbandModel, &RubberbandModel::verticesRemoved, this, &DistanceArea::onVerticesRemoved );
+    disconnect( mRubberbandModel, &RubberbandModel::crsChanged, this, &DistanceArea::recompute );
     disconnect( mRubberbandModel, &RubberbandModel::vertexCountChanged, this, &DistanceArea::areaValidChanged );
     disconnect( mRubberbandModel, &RubberbandModel::vertexCountChanged, this, &DistanceArea::lengthValidChanged );
   }
@@ -88,13 +114,16 @@ void DistanceArea::setRubberbandModel( RubberbandModel *rubberbandModel )
 
   if ( mRubberbandModel )
   {
-    connect( mRubberbandModel, &RubberbandModel::vertexChanged, this, &DistanceArea::lengthChanged );
-    connect( mRubberbandModel, &RubberbandModel::vertexChanged, this, &DistanceArea::areaChanged );
-    connect( mRubberbandModel, &RubberbandModel::vertexChanged, this, &DistanceArea::segmentLengthChanged );
+    connect( mRubberbandModel, &RubberbandModel::vertexChanged, this, &DistanceArea::onVertexChanged );
+    connect( mRubberbandModel, &RubberbandModel::verticesInserted, this, &DistanceArea::onVerticesInserted );
+    connect( mRubberbandModel, &RubberbandModel::verticesRemoved, this, &DistanceArea::onVerticesRemoved );
+    connect( mRubberbandModel, &RubberbandModel::crsChanged, this, &DistanceArea::recompute );
     connect( mRubberbandModel, &RubberbandModel::vertexCountChanged, this, &DistanceArea::areaValidChanged );
     connect( mRubberbandModel, &RubberbandModel::vertexCountChanged, this, &DistanceArea::lengthValidChanged );
   }
 
+  recompute();
+
   emit rubberbandModelChanged();
 }
 
@@ -136,7 +165,7 @@ void DistanceArea::setGeometry( Geometry *geometry )
 qreal DistanceArea::length() const
 {
   if ( mRubberbandModel )
-    return mDistanceArea.measureLine( mRubberbandModel->flatPointSequence( mCrs ) );
+    return mLengthSums.isEmpty() ? 0 : mLengthSums.last();
 
   return qQNaN();
 }
@@ -164,7 +193,7 @@ bool DistanceArea::lengthValid() const
 qreal DistanceArea::area() const
 {
   if ( mRubberbandModel )
-    return mDistanceArea.measurePolygon( mRubberbandModel->flatPointSequence( mCrs ) );
+    return mAreaSums.isEmpty() ? 0 : std::fabs( mAreaSums.last() );
 
   return qQNaN();
 }
@@ -195,20 +224,159 @@ qreal DistanceArea::segmentLength() const
   if ( !mRubberbandModel )
     return qQNaN();
 
-  if ( mRubberbandModel->vertexCount() < 2 )
+  if ( mRubberbandModel->vertexCount() < 2 || mSegmentLengths.isEmpty() )
     return qQNaN();
 
-  QVector<QgsPointXY> points = mRubberbandModel->flatPointSequence( mCrs );
+  return mSegmentLengths.last();
+}
+
+void DistanceArea::recompute()
+{
+  const int count = mRubberbandModel ? mRubberbandModel->vertexCount() : 0;
+
+  mPoints.resize( count );
+  mSegmentLengths.resize( std::max( count - 1, 0 ) );
+  mTriangleAreas.resize( std::max( count - 2, 0 ) );
+  mLengthSums.clear();
+  mAreaSums.clear();
+
+  transformVertices( 0, count );
+  measureVertices( 0, count );
+
+  emitMeasurementsChanged();
+}
+
+void DistanceArea::onVertexChanged( int index )
+{
+  if ( mPoints.size() != mRubberbandModel->vertexCount() || index >= mPoints.size() )
+  {
+    recompute();
+    return;
+  }
 
-  auto pointIt = points.constEnd() - 1;
+  transformVertices( index, 1 );
+  measureVertices( index, index + 1 );
 
-  QVector<QgsPointXY> flatPoints;
+  emitMeasurementsChanged();
+}
 
-  flatPoints << *pointIt;
-  pointIt--;
-  flatPoints << *pointIt;
+void DistanceArea::onVerticesInserted( int index, int count )
+{
+  // The model may have been filled without removing its former vertices first
+  if ( mPoints.size() + count != mRubberbandModel->vertexCount() || index > mPoints.size() )
+  {
+    recompute();
+    return;
+  }
 
-  return mDistanceArea.measureLine( flatPoints );
+  mPoints.insert( index, count, QgsPointXY() );
+
+  // The segment and the triangle spanning the insertion are kept and measured again with the new ones
+  const int segmentCount = std::max( mPoints.size() - 1, 0 );
+  mSegmentLengths.insert( std::min( index, mSegmentLengths.size() ), segmentCount - mSegmentLengths.size(), 0 );
+  const int triangleCount = std::max( mPoints.size() - 2, 0 );
+  mTriangleAreas.insert( qBound( 0, index - 1, mTriangleAreas.size() ), triangleCount - mTriangleAreas.size(), 0 );
+
+  transformVertices( index, count );
+  measureVertices( index, index + count );
+
+  emitMeasurementsChanged();
+}
+
+void DistanceArea::onVerticesRemoved( int index, int count )
+{
+  if ( mPoints.size() - count != mRubberbandModel->vertexCount() || index + count > mPoints.size() )
+  {
+    recompute();
+    return;
+  }
+
+  mPoints.remove( index, count );
+
+  // The segments and triangles around the removed vertices collapse into the one ending at the vertex now at index
+  const int segmentCount = std::max( mPoints.size() - 1, 0 );
+  mSegmentLengths.remove( qBound( 0, index, segmentCount ), mSegmentLengths.size() - segmentCount );
+  const int triangleCount = std::max( mPoints.size() - 2, 0 );
+  mTriangleAreas.remove( qBound( 0, index - 1, triangleCount ), mTriangleAreas.size() - triangleCount );
+
+  measureVertices( index, index + 1 );
+
+  emitMeasurementsChanged();
+}
+
+const QgsDistanceArea &DistanceArea::measurement() const
+{
+  return mDistanceArea.willUseEllipsoid() ? mEllipsoidDistanceArea : mDistanceArea;
+}
+
+QgsCoordinateReferenceSystem DistanceArea::measurementCrs() const
+{
+  return mDistanceArea.willUseEllipsoid() ? mDistanceArea.ellipsoidCrs() : mCrs;
+}
+
+void DistanceArea::transformVertices( int index, int count )
+{
+  if ( count <= 0 )
+    return;
+
+  const QVector<QgsPoint> vertices = mRubberbandModel->vertices();
+  QVector<double> x( count );
+  QVector<double> y( count );
+  QVector<double> z;
+  for ( int i = 0; i < count; ++i )
+  {
+    x[i] = vertices.at( index + i ).x();
+    y[i] = vertices.at( index + i ).y();
+  }
+
+  try
+  {
+    GeometryUtils::transformCoordinates( CoordinateTransformCache::instance()->transform( mRubberbandModel->crs(), measurementCrs() ), x, y, z );
+  }
+  catch ( const QgsCsException &e )
+  {
+    QgsMessageLog::logMessage( QStringLiteral( "Transformation error occurred: %1" ).arg( e.what() ) );
+  }
+
+  for ( int i = 0; i < count; ++i )
+    mPoints[index + i] = QgsPointXY( x.at( i ), y.at( i ) );
+}
+
+void DistanceArea::measureVertices( int from, int to )
+{
+  const QgsDistanceArea &distanceArea = measurement();
+
+  const int firstSegment = std::max( from - 1, 0 );
+  const int lastSegment = std::min( to, mSegmentLengths.size() );
+  for ( int i = firstSegment; i < lastSegment; ++i )
+    mSegmentLengths[i] = distanceArea.measureLine( mPoints.at( i ), mPoints.at( i + 1 ) );
+  updatePrefixSums( mSegmentLengths, mLengthSums, firstSegment );
+
+  // The triangles fan out from the first vertex, moving it changes all of them
+  const int firstTriangle = from == 0 ? 0 : std::max( from - 2, 0 );
+  const int lastTriangle = from == 0 ? mTriangleAreas.size() : std::min( to - 1, mTriangleAreas.size() );
+  for ( int i = firstTriangle; i < lastTriangle; ++i )
+    mTriangleAreas[i] = triangleArea( mPoints.at( 0 ), mPoints.at( i + 1 ), mPoints.at( i + 2 ) );
+  updatePrefixSums( mTriangleAreas, mAreaSums, firstTriangle );
+}
+
+double DistanceArea::triangleArea( const QgsPointXY &a, const QgsPointXY &b, const QgsPointXY &c ) const
+{
+  const double cross = ( b.x() - a.x() ) * ( c.y() - a.y() ) - ( b.y() - a.y() ) * ( c.x() - a.x() );
+  if ( qgsDoubleNear( cross, 0.0 ) )
+    return 0;
+
+  // The edge terms of the ellipsoidal area cancel out along the shared edges of the fan,
+  // the signed triangle areas therefore add up to the area of the polygon
+  const double area = measurement().measurePolygon( QVector<QgsPointXY>() << a << b << c );
+  return cross > 0 ? area : -area;
+}
+
+void DistanceArea::emitMeasurementsChanged()
+{
+  emit lengthChanged();
+  emit areaChanged();
+  emit segmentLengthChanged();
 }
 
 QgsUnitTypes::DistanceUnit DistanceArea::lengthUnits() const
@@ -24,6 +24,15 @@ class Geometry;
 class RubberbandModel;
 class QgsProject;
 
+/**
+ * Measures the line or polygon of a rubberband model.
+ *
+ * The measurements are kept up to date incrementally. The vertices are mirrored in the measurement
+ * CRS together with the length of each segment and the signed area of each triangle of a fan from
+ * the first vertex, both with prefix sums. Moving, adding or removing a vertex only measures the
+ * segments and triangles touching it again, changing the last vertex while digitizing is O(1).
+ * Everything is measured again when the CRS or the ellipsoid changes.
+ */
 class DistanceArea : public QObject
 {
     Q_OBJECT
@@ -80,13 +89,51 @@ class DistanceArea : public QObject
 
   private slots:
     void init();
+    void recompute();
+    void onVertexChanged( int index );
+    void onVerticesInserted( int index, int count );
+    void onVerticesRemoved( int index, int count );
 
   private:
+
+    /**
+     * Returns the measurement to use. With an ellipsoid, the vertices are transformed straight to the
+     * ellipsoid CRS and the measurement does not transform them again.
+     */
+    const QgsDistanceArea &measurement() const;
+
+    //! Returns the CRS of the mirrored vertices
+    QgsCoordinateReferenceSystem measurementCrs() const;
+
+    //! Transforms \a count vertices of the rubberband from \a index into the mirrored vertices
+    void transformVertices( int index, int count );
+
+    //! Measures the segments and triangles touching the vertices from \a from up to \a to (excluded) again
+    void measureVertices( int from, int to );
+
+    //! Returns the signed area of the triangle \a a, \a b, \a c, positive when counterclockwise
+    double triangleArea( const QgsPointXY &a, const QgsPointXY &b, const QgsPointXY &c ) const;
+
+    void emitMeasurementsChanged();
+
     RubberbandModel *mRubberbandModel = nullptr;
     QgsCoordinateReferenceSystem mCrs;
     QgsProject *mProject = nullptr;
 
     QgsDistanceArea mDistanceArea;
+    //! Measures on the ellipsoid with points already in the ellipsoid CRS
+    QgsDistanceArea mEllipsoidDistanceArea;
+
+    //! The vertices of the rubberband in the measurement CRS
+    QVector<QgsPointXY> mPoints;
+    //! Length of the segment from each vertex to the next one
+    QVector<double> mSegmentLengths;
+    //! Prefix sums of the segment lengths, the last one is the length of the line
+    QVector<double> mLengthSums;
+    //! Signed area of the triangle from the first vertex to each following pair of vertices
+    QVector<double> mTriangleAreas;
+    //! Prefix sums of the triangle areas, the last one is the signed area of the polygon
+    QVector<double> mAreaSums;
 };
 
 #endif // DISTANCEAREA_H
@@ -14,6 +14,7 @@
  ***************************************************************************/
 
 #include "featurelistextentcontroller.h"
+#include "coordinatetransformcache.h"
 
 #include <qgsvectorlayer.h>
 #include <qgsgeometry.h>
@@ -52,7 +53,7 @@ void FeatureListExtentController::zoomToSelected( bool skipIfIntersects ) const
     QgsFeature feat = mSelection->focusedFeature();
     QgsVectorLayer *layer = mSelection->focusedLayer();
 
-    QgsCoordinateTransform transf( layer->crs(), mMapSettings->destinationCrs(), mMapSettings->mapSettings().transformContext() );
+    const QgsCoordinateTransform transf = CoordinateTransformCache::instance()->transform( layer->crs(), mMapSettings->destinationCrs(), mMapSettings->mapSettings().transformContext() );
     QgsGeometry geom( feat.geometry() );
     geom.transform( transf );
 
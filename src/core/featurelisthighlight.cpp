@@ -0,0 +1,646 @@
+/***************************************************************************
+  featurelisthighlight.cpp - FeatureListHighlight
+
+ ---------------------
+ begin                : October 2026
+ copyright            : (C) 2026 by QField contributors
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include <QOpenGLContext>
+#include <QOpenGLFunctions>
+#include <QQuickWindow>
+#include <QSGGeometryNode>
+#include <QSGMaterial>
+#include <QSGVertexColorMaterial>
+
+#include <qgsgeometry.h>
+#include <qgsproject.h>
+
+#include "featurelisthighlight.h"
+#include "featurelistmodelselection.h"
+#include "multifeaturelistmodel.h"
+#include "qgsquickmapsettings.h"
+#include "qgsquickmaptransform.h"
+
+#ifndef GL_PROGRAM_POINT_SIZE
+#define GL_PROGRAM_POINT_SIZE 0x8642
+#endif
+#ifndef GL_POINT_SPRITE
+#define GL_POINT_SPRITE 0x8861
+#endif
+
+/**
+ * Draws each vertex as a round point sprite with a border, the fill color is taken from the vertex.
+ */
+class PointSpriteMaterial : public QSGMaterial
+{
+  public:
+    PointSpriteMaterial()
+    {
+      setFlag( Blending );
+    }
+
+    QSGMaterialType *type() const override
+    {
+      static QSGMaterialType type;
+      return &type;
+    }
+
+    QSGMaterialShader *createShader() const override;
+
+    int compare( const QSGMaterial *other ) const override
+    {
+      const PointSpriteMaterial *material = static_cast<const PointSpriteMaterial *>( other );
+      if ( pointSize != material->pointSize )
+        return pointSize < material->pointSize ? -1 : 1;
+      if ( borderRatio != material->borderRatio )
+        return borderRatio < material->borderRatio ? -1 : 1;
+      return borderColor.rgba() == material->borderColor.rgba() ? 0 : ( borderColor.rgba() < material->borderColor.rgba() ? -1 : 1 );
+    }
+
+    //! Diameter in device pixels
+    float pointSize = 1;
+    //! Radius of the fill relative to the radius of the point
+    float borderRatio = 1;
+    QColor borderColor;
+};
+
+class PointSpriteMaterialShader : public QSGMaterialShader
+{
+  public:
+    const char *vertexShader() const override
+    {
+      return "uniform highp mat4 matrix;\n"
+             "uniform highp float pointSize;\n"
+             "attribute highp vec4 vertex;\n"
+             "attribute lowp vec4 color;\n"
+             "varying lowp vec4 vColor;\n"
+             "void main() {\n"
+             "  vColor = color;\n"
+             "  gl_PointSize = pointSize;\n"
+             "  gl_Position = matrix * vertex;\n"
+             "}\n";
+    }
+
+    const char *fragmentShader() const override
+    {
+      return "uniform lowp float opacity;\n"
+             "uniform lowp vec4 borderColor;\n"
+             "uniform highp float borderRatio;\n"
+             "varying lowp vec4 vColor;\n"
+             "void main() {\n"
+             "  highp float radius = length( gl_PointCoord * 2.0 - 1.0 );\n"
+             "  if ( radius > 1.0 )\n"
+             "    discard;\n"
+             "  gl_FragColor = ( radius > borderRatio ? borderColor : vColor ) * opacity;\n"
+             "}\n";
+    }
+
+    char const *const *attributeNames() const override
+    {
+      static char const *const names[] = { "vertex", "color", nullptr };
+      return names;
+    }
+
+    void initialize() override
+    {
+      mMatrixId = program()->uniformLocation( "matrix" );
+      mOpacityId = program()->uniformLocation( "opacity" );
+      mPointSizeId = program()->uniformLocation( "pointSize" );
+      mBorderColorId = program()->uniformLocation( "borderColor" );
+      mBorderRatioId = program()->uniformLocation( "borderRatio" );
+    }
+
+    void updateState( const RenderState &state, QSGMaterial *newMaterial, QSGMaterial *oldMaterial ) override
+    {
+      Q_UNUSED( oldMaterial )
+
+      // OpenGL ES always takes the point size from the shader, desktop OpenGL needs to be told
+      QOpenGLContext *context = QOpenGLContext::currentContext();
+      if ( context && !context->isOpenGLES() )
+      {
+        context->functions()->glEnable( GL_PROGRAM_POINT_SIZE );
+        if ( context->format().profile() != QSurfaceFormat::CoreProfile )
+          context->functions()->glEnable( GL_POINT_SPRITE );
+      }
+
+      if ( state.isMatrixDirty() )
+        program()->setUniformValue( mMatrixId, state.combinedMatrix() );
+      if ( state.isOpacityDirty() )
+        program()->setUniformValue( mOpacityId, state.opacity() );
+
+      const PointSpriteMaterial *material = static_cast<const PointSpriteMaterial *>( newMaterial );
+      const QColor &border = material->borderColor;
+      program()->setUniformValue( mPointSizeId, material->pointSize );
+      program()->setUniformValue( mBorderRatioId, material->borderRatio );
+      program()->setUniformValue( mBorderColorId, QVector4D( border.redF() * border.alphaF(), border.greenF() * border.alphaF(),
+                                  border.blueF() * border.alphaF(), border.alphaF() ) );
+    }
+
+  private:
+    int mMatrixId = -1;
+    int mOpacityId = -1;
+    int mPointSizeId = -1;
+    int mBorderColorId = -1;
+    int mBorderRatioId = -1;
+};
+
+QSGMaterialShader *PointSpriteMaterial::createShader() const
+{
+  return new PointSpriteMaterialShader;
+}
+
+static QSGGeometryNode *createGeometryNode( QSGMaterial *material, unsigned int drawingMode )
+{
+  QSGGeometryNode *node = new QSGGeometryNode;
+  QSGGeometry *sgGeom = new QSGGeometry( QSGGeometry::defaultAttributes_ColoredPoint2D(), 0 );
+  sgGeom->setDrawingMode( drawingMode );
+  node->setGeometry( sgGeom );
+  node->setMaterial( material );
+  node->setFlag( QSGNode::OwnsGeometry );
+  node->setFlag( QSGNode::OwnsMaterial );
+  node->setFlag( QSGNode::OwnedByParent );
+  return node;
+}
+
+static void setVertexPositions( QSGGeometry *sgGeom, const QVector<QgsPointXY> &points, const QgsPointXY &origin )
+{
+  sgGeom->allocate( points.size() );
+  QSGGeometry::ColoredPoint2D *vertices = sgGeom->vertexDataAsColoredPoint2D();
+  for ( int i = 0; i < points.size(); ++i )
+  {
+    vertices[i].x = static_cast<float>( points.at( i ).x() - origin.x() );
+    vertices[i].y = static_cast<float>( points.at( i ).y() - origin.y() );
+  }
+}
+
+static void setVertexColors( QSGGeometry *sgGeom, int start, int count, const QColor &color )
+{
+  // Vertex colors are premultiplied
+  const int alpha = color.alpha();
+  const uchar red = static_cast<uchar>( color.red() * alpha / 255 );
+  const uchar green = static_cast<uchar>( color.green() * alpha / 255 );
+  const uchar blue = static_cast<uchar>( color.blue() * alpha / 255 );
+
+  QSGGeometry::ColoredPoint2D *vertices = sgGeom->vertexDataAsColoredPoint2D() + start;
+  for ( int i = 0; i < count; ++i )
+  {
+    vertices[i].r = red;
+    vertices[i].g = green;
+    vertices[i].b = blue;
+    vertices[i].a = static_cast<uchar>( alpha );
+  }
+}
+
+static void appendSegments( QVector<QgsPointXY> &segments, const QgsPolylineXY &line )
+{
+  for ( int i = 1; i < line.size(); ++i )
+    segments << line.at( i - 1 ) << line.at( i );
+}
+
+FeatureListHighlight::FeatureListHighlight( QQuickItem *parent )
+  : QQuickItem( parent )
+{
+  setFlags( QQuickItem::ItemHasContents );
+}
+
+FeatureListModelSelection *FeatureListHighlight::selectionModel() const
+{
+  return mSelectionModel;
+}
+
+void FeatureListHighlight::setSelectionModel( FeatureListModelSelection *selectionModel )
+{
+  if ( mSelectionModel == selectionModel )
+    return;
+
+  if ( mSelectionModel )
+  {
+    disconnect( mSelectionModel, &FeatureListModelSelection::modelChanged, this, &FeatureListHighlight::onModelChanged );
+    disconnect( mSelectionModel, &FeatureListModelSelection::focusedItemChanged, this, &FeatureListHighlight::markColorsDirty );
+    disconnect( mSelectionModel, &FeatureListModelSelection::selectedFeaturesChanged, this, &FeatureListHighlight::markColorsDirty );
+  }
+
+  mSelectionModel = selectionModel;
+
+  if ( mSelectionModel )
+  {
+    connect( mSelectionModel, &FeatureListModelSelection::modelChanged, this, &FeatureListHighlight::onModelChanged );
+    connect( mSelectionModel, &FeatureListModelSelection::focusedItemChanged, this, &FeatureListHighlight::markColorsDirty );
+    connect( mSelectionModel, &FeatureListModelSelection::selectedFeaturesChanged, this, &FeatureListHighlight::markColorsDirty );
+  }
+
+  onModelChanged();
+
+  emit selectionModelChanged();
+}
+
+void FeatureListHighlight::onModelChanged()
+{
+  MultiFeatureListModel *model = mSelectionModel ? mSelectionModel->model() : nullptr;
+  if ( mModel != model )
+  {
+    if ( mModel )
+      disconnect( mModel, nullptr, this, nullptr );
+
+    mModel = model;
+
+    if ( mModel )
+    {
+      connect( mModel, &MultiFeatureListModel::rowsInserted, this, &FeatureListHighlight::markGeometriesDirty );
+      connect( mModel, &MultiFeatureListModel::rowsRemoved, this, &FeatureListHighlight::markGeometriesDirty );
+      connect( mModel, &MultiFeatureListModel::rowsMoved, this, &FeatureListHighlight::markGeometriesDirty );
+      connect( mModel, &MultiFeatureListModel::modelReset, this, &FeatureListHighlight::markGeometriesDirty );
+      connect( mModel, &MultiFeatureListModel::layoutChanged, this, &FeatureListHighlight::markGeometriesDirty );
+      connect( mModel, &MultiFeatureListModel::dataChanged, this, &FeatureListHighlight::onModelDataChanged );
+      connect( mModel, &MultiFeatureListModel::selectedCountChanged, this, &FeatureListHighlight::markColorsDirty );
+    }
+  }
+
+  markGeometriesDirty();
+}
+
+void FeatureListHighlight::onModelDataChanged( const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles )
+{
+  Q_UNUSED( topLeft )
+  Q_UNUSED( bottomRight )
+
+  // A changed selection keeps the geometries, only the colors are updated
+  if ( roles.size() == 1 && roles.at( 0 ) == MultiFeatureListModel::FeatureSelectedRole )
+    markColorsDirty();
+  else
+    markGeometriesDirty();
+}
+
+QgsQuickMapSettings *FeatureListHighlight::mapSettings() const
+{
+  return mMapSettings;
+}
+
+void FeatureListHighlight::setMapSettings( QgsQuickMapSettings *mapSettings )
+{
+  if ( mMapSettings == mapSettings )
+    return;
+
+  if ( mMapSettings )
+  {
+    disconnect( mMapSettings, &QgsQuickMapSettings::destinationCrsChanged, this, &FeatureListHighlight::markGeometriesDirty );
+    disconnect( mMapSettings, &QgsQuickMapSettings::visibleExtentChanged, this, &FeatureListHighlight::onVisibleExtentChanged );
+    disconnect( mMapSettings, &QgsQuickMapSettings::mapUnitsPerPointChanged, this, &FeatureListHighlight::onMapUnitsPerPointChanged );
+  }
+
+  mMapSettings = mapSettings;
+
+  if ( mMapSettings )
+  {
+    connect( mMapSettings, &QgsQuickMapSettings::destinationCrsChanged, this, &FeatureListHighlight::markGeometriesDirty );
+    connect( mMapSettings, &QgsQuickMapSettings::visibleExtentChanged, this, &FeatureListHighlight::onVisibleExtentChanged );
+    connect( mMapSettings, &QgsQuickMapSettings::mapUnitsPerPointChanged, this, &FeatureListHighlight::onMapUnitsPerPointChanged );
+  }
+
+  markGeometriesDirty();
+
+  emit mapSettingsChanged();
+}
+
+void FeatureListHighlight::markGeometriesDirty()
+{
+  mGeometriesDirty = true;
+  update();
+}
+
+void FeatureListHighlight::markColorsDirty()
+{
+  mColorsDirty = true;
+  update();
+}
+
+void FeatureListHighlight::onVisibleExtentChanged()
+{
+  // Only the transform changes, the vertices are kept
+  update();
+}
+
+void FeatureListHighlight::onMapUnitsPerPointChanged()
+{
+  if ( QgsSGTessellator::levelOfDetail( mMapSettings->mapUnitsPerPoint() ) != mLevelOfDetail )
+    markGeometriesDirty();
+}
+
+FeatureListHighlight::HighlightState FeatureListHighlight::featureState( int row ) const
+{
+  if ( mModel->data( mModel->index( row, 0 ), MultiFeatureListModel::FeatureSelectedRole ).toBool() )
+    return Selected;
+
+  if ( mModel->selectedCount() == 0 && row == mSelectionModel->focusedItem() )
+    return Focused;
+
+  return Normal;
+}
+
+QColor FeatureListHighlight::stateColor( FeatureListHighlight::HighlightState state ) const
+{
+  switch ( state )
+  {
+    case Focused:
+      return mFocusedColor;
+    case Selected:
+      return mSelectedColor;
+    case Normal:
+      break;
+  }
+  return mColor;
+}
+
+QSGNode *FeatureListHighlight::updatePaintNode( QSGNode *n, QQuickItem::UpdatePaintNodeData * )
+{
+  if ( !mMapSettings )
+  {
+    delete n;
+    return nullptr;
+  }
+
+  if ( !n )
+  {
+    n = new QSGTransformNode;
+    n->appendChildNode( createGeometryNode( new QSGVertexColorMaterial, QSGGeometry::DrawTriangles ) );
+    n->appendChildNode( createGeometryNode( new QSGVertexColorMaterial, QSGGeometry::DrawLines ) );
+    n->appendChildNode( createGeometryNode( new PointSpriteMaterial, QSGGeometry::DrawPoints ) );
+    mGeometriesDirty = true;
+  }
+
+  if ( !mGeometriesDirty && mColorsDirty && mModel && mModel->rowCount() != mFeatureVertices.size() )
+    mGeometriesDirty = true;
+
+  if ( mGeometriesDirty )
+    rebuildGeometries( n );
+  else if ( mColorsDirty )
+    updateColors( n );
+
+  mGeometriesDirty = false;
+  mColorsDirty = false;
+
+  QSGGeometryNode *pointNode = static_cast<QSGGeometryNode *>( n->lastChild() );
+  PointSpriteMaterial *pointMaterial = static_cast<PointSpriteMaterial *>( pointNode->material() );
+  const qreal devicePixelRatio = window() ? window()->effectiveDevicePixelRatio() : 1.0;
+  pointMaterial->pointSize = static_cast<float>( mPointSize * devicePixelRatio );
+  pointMaterial->borderRatio = mPointSize > 0 ? static_cast<float>( 1.0 - 2 * mBorderSize / mPointSize ) : 1.0f;
+  pointMaterial->borderColor = mBorderColor;
+  pointNode->markDirty( QSGNode::DirtyMaterial );
+
+  static_cast<QSGTransformNode *>( n )->setMatrix( QgsQuickMapTransform::matrix( mMapSettings, mOrigin ) );
+
+  return n;
+}
+
+void FeatureListHighlight::rebuildGeometries( QSGNode *n )
+{
+  QVector<QgsPointXY> triangles;
+  QVector<QgsPointXY> segments;
+  QVector<QgsPointXY> points;
+
+  const int rowCount = mModel ? mModel->rowCount() : 0;
+  mFeatureVertices.fill( FeatureVertices(), rowCount );
+
+  mLevelOfDetail = QgsSGTessellator::levelOfDetail( mMapSettings->mapUnitsPerPoint() );
+  bool hasOrigin = false;
+  for ( int row = 0; row < rowCount; ++row )
+  {
+    const QModelIndex index = mModel->index( row, 0 );
+    const QgsGeometry geometry = mModel->data( index, MultiFeatureListModel::GeometryRole ).value<QgsGeometry>();
+    const QgsCoordinateReferenceSystem crs = mModel->data( index, MultiFeatureListModel::CrsRole ).value<QgsCoordinateReferenceSystem>();
+
+    FeatureVertices &vertices = mFeatureVertices[row];
+    vertices.state = featureState( row );
+    vertices.triangleStart = triangles.size();
+    vertices.lineStart = segments.size();
+    vertices.pointStart = points.size();
+
+    if ( !geometry.isNull() )
+    {
+      // Transformed geometries and triangles are shared with the other highlights
+      const QgsSGTessellator::Tessellation tessellation = QgsSGTessellator::instance()->tessellation( geometry, crs, mMapSettings->destinationCrs(), QgsProject::instance()->transformContext(), mLevelOfDetail );
+      const QgsGeometry &transformed = tessellation.geometry;
+
+      if ( !hasOrigin )
+      {
+        mOrigin = transformed.boundingBox().center();
+        hasOrigin = true;
+      }
+
+      switch ( transformed.type() )
+      {
+        case QgsWkbTypes::PointGeometry:
+        {
+          for ( auto it = transformed.vertices_begin(); it != transformed.vertices_end(); ++it )
+            points << QgsPointXY( ( *it ).x(), ( *it ).y() );
+          break;
+        }
+
+        case QgsWkbTypes::LineGeometry:
+        {
+          const QgsMultiPolylineXY lines = transformed.isMultipart() ? transformed.asMultiPolyline() : QgsMultiPolylineXY() << transformed.asPolyline();
+          for ( const QgsPolylineXY &line : lines )
+            appendSegments( segments, line );
+          break;
+        }
+
+        case QgsWkbTypes::PolygonGeometry:
+        {
+          triangles << tessellation.triangles;
+          const QgsMultiPolygonXY polygons = transformed.isMultipart() ? transformed.asMultiPolygon() : QgsMultiPolygonXY() << transformed.asPolygon();
+          for ( const QgsPolygonXY &polygon : polygons )
+          {
+            for ( const QgsPolylineXY &ring : polygon )
+              appendSegments( segments, ring );
+          }
+          break;
+        }
+
+        case QgsWkbTypes::UnknownGeometry:
+        case QgsWkbTypes::NullGeometry:
+          break;
+      }
+    }
+
+    vertices.triangleCount = triangles.size() - vertices.triangleStart;
+    vertices.lineCount = segments.size() - vertices.lineStart;
+    vertices.pointCount = points.size() - vertices.pointStart;
+  }
+
+  QSGGeometryNode *triangleNode = static_cast<QSGGeometryNode *>( n->firstChild() );
+  QSGGeometryNode *lineNode = static_cast<QSGGeometryNode *>( triangleNode->nextSibling() );
+  QSGGeometryNode *pointNode = static_cast<QSGGeometryNode *>( lineNode->nextSibling() );
+
+  setVertexPositions( triangleNode->geometry(), triangles, mOrigin );
+  setVertexPositions( lineNode->geometry(), segments, mOrigin );
+  setVertexPositions( pointNode->geometry(), points, mOrigin );
+  lineNode->geometry()->setLineWidth( static_cast<float>( mLineWidth ) );
+
+  for ( const FeatureVertices &vertices : qgis::as_const( mFeatureVertices ) )
+  {
+    const QColor color = stateColor( vertices.state );
+    QColor fillColor = color;
+    fillColor.setAlphaF( color.alphaF() * 0.5 );
+
+    setVertexColors( triangleNode->geometry(), vertices.triangleStart, vertices.triangleCount, fillColor );
+    setVertexColors( lineNode->geometry(), vertices.lineStart, vertices.lineCount, color );
+    setVertexColors( pointNode->geometry(), vertices.pointStart, vertices.pointCount, color );
+  }
+
+  triangleNode->markDirty( QSGNode::DirtyGeometry );
+  lineNode->markDirty( QSGNode::DirtyGeometry );
+  pointNode->markDirty( QSGNode::DirtyGeometry );
+}
+
+void FeatureListHighlight::updateColors( QSGNode *n )
+{
+  QSGGeometryNode *triangleNode = static_cast<QSGGeometryNode *>( n->firstChild() );
+  QSGGeometryNode *lineNode = static_cast<QSGGeometryNode *>( triangleNode->nextSibling() );
+  QSGGeometryNode *pointNode = static_cast<QSGGeometryNode *>( lineNode->nextSibling() );
+
+  bool changed = false;
+  for ( int row = 0; row < mFeatureVertices.size(); ++row )
+  {
+    FeatureVertices &vertices = mFeatureVertices[row];
+    const HighlightState state = featureState( row );
+    if ( state == vertices.state )
+      continue;
+
+    vertices.state = state;
+    const QColor color = stateColor( state );
+    QColor fillColor = color;
+    fillColor.setAlphaF( color.alphaF() * 0.5 );
+
+    setVertexColors( triangleNode->geometry(), vertices.triangleStart, vertices.triangleCount, fillColor );
+    setVertexColors( lineNode->geometry(), vertices.lineStart, vertices.lineCount, color );
+    setVertexColors( pointNode->geometry(), vertices.pointStart, vertices.pointCount, color );
+    changed = true;
+  }
+
+  if ( changed )
+  {
+    triangleNode->markDirty( QSGNode::DirtyGeometry );
+    lineNode->markDirty( QSGNode::DirtyGeometry );
+    pointNode->markDirty( QSGNode::DirtyGeometry );
+  }
+}
+
+QColor FeatureListHighlight::color() const
+{
+  return mColor;
+}
+
+void FeatureListHighlight::setColor( const QColor &color )
+{
+  if ( mColor == color )
+    return;
+
+  mColor = color;
+  markGeometriesDirty();
+
+  emit colorChanged();
+}
+
+QColor FeatureListHighlight::focusedColor() const
+{
+  return mFocusedColor;
+}
+
+void FeatureListHighlight::setFocusedColor( const QColor &color )
+{
+  if ( mFocusedColor == color )
+    return;
+
+  mFocusedColor = color;
+  markGeometriesDirty();
+
+  emit focusedColorChanged();
+}
+
+QColor FeatureListHighlight::selectedColor() const
+{
+  return mSelectedColor;
+}
+
+void FeatureListHighlight::setSelectedColor( const QColor &color )
+{
+  if ( mSelectedColor == color )
+    return;
+
+  mSelectedColor = color;
+  markGeometriesDirty();
+
+  emit selectedColorChanged();
+}
+
+qreal FeatureListHighlight::lineWidth() const
+{
+  return mLineWidth;
+}
+
+void FeatureListHighlight::setLineWidth( qreal width )
+{
+  if ( mLineWidth == width )
+    return;
+
+  mLineWidth = width;
+  markGeometriesDirty();
+
+  emit lineWidthChanged();
+}
+
+qreal FeatureListHighlight::pointSize() const
+{
+  return mPointSize;
+}
+
+void FeatureListHighlight::setPointSize( qreal size )
+{
+  if ( mPointSize == size )
+    return;
+
+  mPointSize = size;
+  update();
+
+  emit pointSizeChanged();
+}
+
+QColor FeatureListHighlight::borderColor() const
+{
+  return mBorderColor;
+}
+
+void FeatureListHighlight::setBorderColor( const QColor &color )
+{
+  if ( mBorderColor == color )
+    return;
+
+  mBorderColor = color;
+  update();
+
+  emit borderColorChanged();
+}
+
+qreal FeatureListHighlight::borderSize() const
+{
+  return mBorderSize;
+}
+
+void FeatureListHighlight::setBorderSize( qreal size )
+{
+  if ( mBorderSize == size )
+    return;
+
+  mBorderSize = size;
+  update();
+
+  emit borderSizeChanged();
+}
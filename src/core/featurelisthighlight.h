@@ -0,0 +1,178 @@
+/***************************************************************************
+  featurelisthighlight.h - FeatureListHighlight
+
+ ---------------------
+ begin                : October 2026
+ copyright            : (C) 2026 by QField contributors
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+#ifndef FEATURELISTHIGHLIGHT_H
+#define FEATURELISTHIGHLIGHT_H
+
+#include <QQuickItem>
+#include <QVector>
+
+#include <qgspointxy.h>
+
+#include "qgssgtessellator.h"
+
+class FeatureListModelSelection;
+class MultiFeatureListModel;
+class QgsQuickMapSettings;
+
+/**
+ * @brief The FeatureListHighlight class highlights the geometries of all features
+ * of the model of a FeatureListModelSelection.
+ *
+ * All geometries are drawn with a single scene graph subtree: one node for the merged
+ * triangles of polygons, one for the merged line segments of lines and polygon outlines
+ * and one for point sprites. The color of each feature is a vertex attribute, changing
+ * the selected or focused features only rewrites the colors of the affected vertices.
+ *
+ * The vertices are stored relative to a local origin and transformed based on mapSettings,
+ * the item must not be placed under a MapTransform. Lines and polygons are simplified
+ * to the level of detail of the current scale.
+ */
+class FeatureListHighlight : public QQuickItem
+{
+    Q_OBJECT
+
+    Q_PROPERTY( FeatureListModelSelection *selectionModel READ selectionModel WRITE setSelectionModel NOTIFY selectionModelChanged )
+    Q_PROPERTY( QgsQuickMapSettings *mapSettings READ mapSettings WRITE setMapSettings NOTIFY mapSettingsChanged )
+    //! Color of features which are neither selected nor focused
+    Q_PROPERTY( QColor color READ color WRITE setColor NOTIFY colorChanged )
+    //! Color of the focused feature, used while no feature is selected
+    Q_PROPERTY( QColor focusedColor READ focusedColor WRITE setFocusedColor NOTIFY focusedColorChanged )
+    //! Color of the selected features
+    Q_PROPERTY( QColor selectedColor READ selectedColor WRITE setSelectedColor NOTIFY selectedColorChanged )
+    //! Width of lines and polygon outlines
+    Q_PROPERTY( qreal lineWidth READ lineWidth WRITE setLineWidth NOTIFY lineWidthChanged )
+    //! Diameter of points
+    Q_PROPERTY( qreal pointSize READ pointSize WRITE setPointSize NOTIFY pointSizeChanged )
+    //! Color of the border of points
+    Q_PROPERTY( QColor borderColor READ borderColor WRITE setBorderColor NOTIFY borderColorChanged )
+    //! Width of the border of points
+    Q_PROPERTY( qreal borderSize READ borderSize WRITE setBorderSize NOTIFY borderSizeChanged )
+
+  public:
+    explicit FeatureListHighlight( QQuickItem *parent = nullptr );
+
+    FeatureListModelSelection *selectionModel() const;
+    void setSelectionModel( FeatureListModelSelection *selectionModel );
+
+    QgsQuickMapSettings *mapSettings() const;
+    void setMapSettings( QgsQuickMapSettings *mapSettings );
+
+    //! \copydoc color
+    QColor color() const;
+    //! \copydoc color
+    void setColor( const QColor &color );
+
+    //! \copydoc focusedColor
+    QColor focusedColor() const;
+    //! \copydoc focusedColor
+    void setFocusedColor( const QColor &color );
+
+    //! \copydoc selectedColor
+    QColor selectedColor() const;
+    //! \copydoc selectedColor
+    void setSelectedColor( const QColor &color );
+
+    //! \copydoc lineWidth
+    qreal lineWidth() const;
+    //! \copydoc lineWidth
+    void setLineWidth( qreal width );
+
+    //! \copydoc pointSize
+    qreal pointSize() const;
+    //! \copydoc pointSize
+    void setPointSize( qreal size );
+
+    //! \copydoc borderColor
+    QColor borderColor() const;
+    //! \copydoc borderColor
+    void setBorderColor( const QColor &color );
+
+    //! \copydoc borderSize
+    qreal borderSize() const;
+    //! \copydoc borderSize
+    void setBorderSize( qreal size );
+
+  signals:
+    void selectionModelChanged();
+    void mapSettingsChanged();
+    //! \copydoc color
+    void colorChanged();
+    //! \copydoc focusedColor
+    void focusedColorChanged();
+    //! \copydoc selectedColor
+    void selectedColorChanged();
+    //! \copydoc lineWidth
+    void lineWidthChanged();
+    //! \copydoc pointSize
+    void pointSizeChanged();
+    //! \copydoc borderColor
+    void borderColorChanged();
+    //! \copydoc borderSize
+    void borderSizeChanged();
+
+  private slots:
+    void markGeometriesDirty();
+    void markColorsDirty();
+    void onModelDataChanged( const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles );
+    void onModelChanged();
+    void onVisibleExtentChanged();
+    void onMapUnitsPerPointChanged();
+
+  private:
+    enum HighlightState
+    {
+      Normal,
+      Focused,
+      Selected,
+    };
+
+    //! Ranges of the vertices of a feature in the merged geometries
+    struct FeatureVertices
+    {
+      int triangleStart = 0;
+      int triangleCount = 0;
+      int lineStart = 0;
+      int lineCount = 0;
+      int pointStart = 0;
+      int pointCount = 0;
+      HighlightState state = Normal;
+    };
+
+    QSGNode *updatePaintNode( QSGNode *n, QQuickItem::UpdatePaintNodeData * ) override;
+
+    HighlightState featureState( int row ) const;
+    QColor stateColor( HighlightState state ) const;
+    void rebuildGeometries( QSGNode *n );
+    void updateColors( QSGNode *n );
+
+    FeatureListModelSelection *mSelectionModel = nullptr;
+    MultiFeatureListModel *mModel = nullptr;
+    QgsQuickMapSettings *mMapSettings = nullptr;
+    QColor mColor = QColor( 255, 255, 0 );
+    QColor mFocusedColor = QColor( 255, 0, 0 );
+    QColor mSelectedColor = QColor( 0, 128, 0 );
+    qreal mLineWidth = 8;
+    qreal mPointSize = 20;
+    QColor mBorderColor = QColor( 0, 0, 255 );
+    qreal mBorderSize = 2;
+
+    bool mGeometriesDirty = false;
+    bool mColorsDirty = false;
+    QVector<FeatureVertices> mFeatureVertices;
+    QgsPointXY mOrigin;
+    int mLevelOfDetail = QgsSGTessellator::FullDetail;
+};
+
+#endif // FEATURELISTHIGHLIGHT_H
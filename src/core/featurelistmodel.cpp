@@ -19,6 +19,7 @@
 #include <qgsproject.h>
 #include <qgsexpressioncontextutils.h>
 #include <qgsvaluerelationfieldformatter.h>
+#include <qgsvectorlayerfeatureiterator.h>
 
 FeatureListModel::FeatureListModel( QObject *parent )
   : QAbstractItemModel( parent )
@@ -29,6 +30,11 @@ FeatureListModel::FeatureListModel( QObject *parent )
   connect( &mReloadTimer, &QTimer::timeout, this, &FeatureListModel::processReloadLayer );
 }
 
+FeatureListModel::~FeatureListModel()
+{
+  cancelReload();
+}
+
 QModelIndex FeatureListModel::index( int row, int column, const QModelIndex &parent ) const
 {
   Q_UNUSED( column )
@@ -96,6 +102,7 @@ void FeatureListModel::setCurrentLayer( QgsVectorLayer *currentLayer )
     disconnect( mCurrentLayer, &QgsVectorLayer::featureAdded, this, &FeatureListModel::onFeatureAdded );
     disconnect( mCurrentLayer, &QgsVectorLayer::attributeValueChanged, this, &FeatureListModel::onAttributeValueChanged );
     disconnect( mCurrentLayer, &QgsVectorLayer::featureDeleted, this, &FeatureListModel::onFeatureDeleted );
+    disconnect( mCurrentLayer, &QgsVectorLayer::displayExpressionChanged, this, &FeatureListModel::reloadLayer );
   }
 
   mCurrentLayer = currentLayer;
@@ -105,6 +112,7 @@ void FeatureListModel::setCurrentLayer( QgsVectorLayer *currentLayer )
     connect( currentLayer, &QgsVectorLayer::featureAdded, this, &FeatureListModel::onFeatureAdded );
     connect( mCurrentLayer, &QgsVectorLayer::attributeValueChanged, this, &FeatureListModel::onAttributeValueChanged );
     connect( currentLayer, &QgsVectorLayer::featureDeleted, this, &FeatureListModel::onFeatureDeleted );
+    connect( mCurrentLayer, &QgsVectorLayer::displayExpressionChanged, this, &FeatureListModel::reloadLayer );
   }
 
   reloadLayer();
@@ -148,41 +156,270 @@ void FeatureListModel::setDisplayValueField( const QString &displayValueField )
 
 int FeatureListModel::findKey( const QVariant &key ) const
 {
-  int idx = 0;
-  for ( const Entry &entry : mEntries )
+  const int row = keyRow( key );
+  if ( row >= 0 )
+    return row;
+
+  // The key may be on a page not fetched yet, it must not be mistaken for NULL
+  if ( mAddNull && mPageSize == 0 )
+    return 0;
+
+  return -1;
+}
+
+QList<int> FeatureListModel::findKeys( const QVariantList &keys ) const
+{
+  QList<int> rows;
+  rows.reserve( keys.size() );
+  for ( const QVariant &key : keys )
+    rows << findKey( key );
+
+  return rows;
+}
+
+int FeatureListModel::keyRow( const QVariant &key ) const
+{
+  if ( key.isNull() )
+    return mNullKeyRow;
+
+  // Keys are indexed by their string representation, which also matches keys of another type
+  return mRowsByKey.value( key.toString(), -1 );
+}
+
+void FeatureListModel::indexKeys( int from )
+{
+  for ( int row = from; row < mEntries.size(); ++row )
   {
-    if ( entry.key == key )
-      return idx;
+    // The null entry is not a feature
+    if ( !mAddNull || row > 0 )
+      mRowsByFid.insert( mEntries.at( row ).fid, row );
 
-    ++idx;
+    const QVariant &key = mEntries.at( row ).key;
+    if ( key.isNull() )
+    {
+      if ( mNullKeyRow < 0 )
+        mNullKeyRow = row;
+      continue;
+    }
+
+    const QString keyString = key.toString();
+    if ( !mRowsByKey.contains( keyString ) )
+      mRowsByKey.insert( keyString, row );
   }
+}
 
-  if ( mAddNull )
-    return 0;
+void FeatureListModel::unindexKeys( int from )
+{
+  if ( mNullKeyRow >= from )
+    mNullKeyRow = -1;
 
-  return -1;
+  for ( int row = from; row < mEntries.size(); ++row )
+  {
+    const Entry &entry = mEntries.at( row );
+    if ( !entry.key.isNull() )
+    {
+      const auto it = mRowsByKey.find( entry.key.toString() );
+      if ( it != mRowsByKey.end() && it.value() == row )
+        mRowsByKey.erase( it );
+    }
+
+    const auto fidIt = mRowsByFid.find( entry.fid );
+    if ( fidIt != mRowsByFid.end() && fidIt.value() == row )
+      mRowsByFid.erase( fidIt );
+  }
 }
 
-void FeatureListModel::onFeatureAdded()
+void FeatureListModel::onFeatureAdded( QgsFeatureId fid )
 {
-  reloadLayer();
+  // Pages are contiguous, a change may move the following ones
+  if ( isLoading() || mPageSize > 0 )
+  {
+    reloadLayer();
+    return;
+  }
+
+  Entry entry;
+  if ( entryForFeature( fid, entry ) )
+    insertEntry( entry );
 }
 
-void FeatureListModel::onAttributeValueChanged( QgsFeatureId, int idx, const QVariant & )
+void FeatureListModel::onAttributeValueChanged( QgsFeatureId fid, int idx, const QVariant & )
 {
-  QgsExpressionContext context = mCurrentLayer->createExpressionContext();
-  QgsExpression expression( mCurrentLayer->displayExpression() );
-  expression.prepare( &context );
-  QSet<QString> referencedColumns = expression.referencedColumns();
-  referencedColumns << mDisplayValueField;
+  if ( !mReferencedColumns.contains( QgsFeatureRequest::ALL_ATTRIBUTES )
+       && !mReferencedColumns.contains( mCurrentLayer->fields().at( idx ).name() ) )
+    return;
 
-  if ( referencedColumns.contains( mCurrentLayer->fields().at( idx ).name() ) )
+  if ( isLoading() || mPageSize > 0 )
+  {
     reloadLayer();
+    return;
+  }
+
+  updateFeature( fid );
 }
 
-void FeatureListModel::onFeatureDeleted()
+void FeatureListModel::onFeatureDeleted( QgsFeatureId fid )
 {
-  reloadLayer();
+  if ( isLoading() || mPageSize > 0 )
+  {
+    reloadLayer();
+    return;
+  }
+
+  const int row = featureRow( fid );
+  if ( row >= 0 )
+    removeEntry( row );
+}
+
+QgsFeatureRequest FeatureListModel::featureRequest() const
+{
+  QgsFeatureRequest request;
+  QStringList filters;
+  QgsExpressionContext filterContext = QgsExpressionContext( QgsExpressionContextUtils::globalProjectLayerScopes( mCurrentLayer ) );
+
+  if ( ! mFilterExpression.isEmpty()
+       && ( ! QgsValueRelationFieldFormatter::expressionRequiresFormScope( mFilterExpression )
+            || QgsValueRelationFieldFormatter::expressionIsUsable( mFilterExpression, mCurrentFormFeature )
+          ) )
+  {
+    if ( mCurrentFormFeature.isValid( ) && QgsValueRelationFieldFormatter::expressionRequiresFormScope( mFilterExpression ) )
+      filterContext.appendScope( QgsExpressionContextUtils::formScope( mCurrentFormFeature ) );
+
+    filters << mFilterExpression;
+  }
+
+  if ( !mSearchTerm.isEmpty() )
+  {
+    QString pattern = mSearchTerm;
+    pattern.replace( '\\', QLatin1String( "\\\\" ) ).replace( '%', QLatin1String( "\\%" ) ).replace( '_', QLatin1String( "\\_" ) );
+    filters << QStringLiteral( "to_string(%1) ILIKE %2" ).arg( displayExpression(), QgsExpression::quotedString( QStringLiteral( "%%1%" ).arg( pattern ) ) );
+  }
+
+  if ( !filters.isEmpty() )
+  {
+    request.setExpressionContext( filterContext );
+    request.setFilterExpression( filters.size() == 1 ? filters.first() : QStringLiteral( "(%1)" ).arg( filters.join( QStringLiteral( ") AND (" ) ) ) );
+  }
+
+  return request;
+}
+
+QString FeatureListModel::displayExpression() const
+{
+  return mDisplayValueField.isEmpty() ? mCurrentLayer->displayExpression() : QgsExpression::quotedColumnRef( mDisplayValueField );
+}
+
+bool FeatureListModel::entryForFeature( QgsFeatureId fid, Entry &entry ) const
+{
+  QgsFeature feature;
+  if ( !mCurrentLayer->getFeatures( QgsFeatureRequest( fid ) ).nextFeature( feature ) )
+    return false;
+
+  QgsFeatureRequest request = featureRequest();
+  if ( request.filterExpression() )
+  {
+    QgsExpressionContext filterContext = *request.expressionContext();
+    filterContext.setFeature( feature );
+    QgsExpression filter( *request.filterExpression() );
+    filter.prepare( &filterContext );
+    if ( !filter.evaluate( &filterContext ).toBool() )
+      return false;
+  }
+
+  QString displayString;
+  if ( mDisplayValueField.isEmpty() )
+  {
+    QgsExpressionContext context = mCurrentLayer->createExpressionContext();
+    context.setFeature( feature );
+    displayString = QgsExpression( mCurrentLayer->displayExpression() ).evaluate( &context ).toString();
+  }
+  else
+  {
+    displayString = feature.attribute( mDisplayValueField ).toString();
+  }
+
+  entry = Entry( displayString, feature.attribute( mKeyField ), feature.id() );
+  return true;
+}
+
+int FeatureListModel::featureRow( QgsFeatureId fid ) const
+{
+  return mRowsByFid.value( fid, -1 );
+}
+
+void FeatureListModel::insertEntry( const Entry &entry )
+{
+  int row = mEntries.size();
+  if ( mOrderByValue )
+    row = static_cast<int>( std::upper_bound( mEntries.constBegin(), mEntries.constEnd(), entry, &FeatureListModel::entryLessThan ) - mEntries.constBegin() );
+
+  // The null entry stays first
+  if ( mAddNull && row == 0 )
+    row = 1;
+
+  beginInsertRows( QModelIndex(), row, row );
+  // Only the rows from the new entry on move, the index of the previous ones is kept
+  unindexKeys( row );
+  mEntries.insert( row, entry );
+  indexKeys( row );
+  endInsertRows();
+}
+
+void FeatureListModel::removeEntry( int row )
+{
+  beginRemoveRows( QModelIndex(), row, row );
+  unindexKeys( row );
+  mEntries.removeAt( row );
+  indexKeys( row );
+  endRemoveRows();
+}
+
+void FeatureListModel::updateFeature( QgsFeatureId fid )
+{
+  const int row = featureRow( fid );
+
+  Entry entry;
+  if ( !entryForFeature( fid, entry ) )
+  {
+    if ( row >= 0 )
+      removeEntry( row );
+    return;
+  }
+
+  if ( row < 0 )
+  {
+    insertEntry( entry );
+    return;
+  }
+
+  const bool inOrder = !mOrderByValue
+                       || ( ( row == 0 || !entryLessThan( entry, mEntries.at( row - 1 ) ) )
+                            && ( row == mEntries.size() - 1 || !entryLessThan( mEntries.at( row + 1 ), entry ) ) );
+  if ( !inOrder )
+  {
+    removeEntry( row );
+    insertEntry( entry );
+    return;
+  }
+
+  const bool keyChanged = mEntries.at( row ).key != entry.key;
+  if ( keyChanged )
+    unindexKeys( row );
+  mEntries[row] = entry;
+  if ( keyChanged )
+    indexKeys( row );
+  emit dataChanged( index( row, 0, QModelIndex() ), index( row, 0, QModelIndex() ) );
+}
+
+bool FeatureListModel::entryLessThan( const Entry &entry1, const Entry &entry2 )
+{
+  if ( entry1.key.isNull() )
+    return true;
+
+  if ( entry2.key.isNull() )
+    return false;
+
+  return entry1.displayString.toLower() < entry2.displayString.toLower();
 }
 
 QgsFeature FeatureListModel::getFeatureFromKeyValue( const QVariant &value ) const
@@ -190,26 +427,80 @@ QgsFeature FeatureListModel::getFeatureFromKeyValue( const QVariant &value ) con
   if ( !mCurrentLayer )
     return QgsFeature();
 
+  const int row = keyRow( value );
+  if ( row >= 0 )
+    return mCurrentLayer->getFeature( mEntries.at( row ).fid );
+
+  // The page with the feature may not be fetched yet
   QgsFeature feature;
-  for ( auto &entry : mEntries )
+  if ( mPageSize > 0 && !value.isNull() )
+  {
+    QgsFeatureRequest request( QgsExpression::createFieldEqualityExpression( mKeyField, value ) );
+    request.setLimit( 1 );
+    mCurrentLayer->getFeatures( request ).nextFeature( feature );
+  }
+
+  return feature;
+}
+
+QList<QgsFeature> FeatureListModel::getFeaturesFromKeyValues( const QVariantList &values ) const
+{
+  QList<QgsFeature> features;
+  if ( !mCurrentLayer )
+    return features;
+
+  QList<QgsFeatureId> fids;
+  QgsFeatureIds requestedFids;
+  fids.reserve( values.size() );
+  for ( const QVariant &value : values )
   {
-    if ( entry.key == value )
+    const int row = keyRow( value );
+    if ( row >= 0 )
     {
-      feature = mCurrentLayer->getFeature( entry.fid );
+      fids << mEntries.at( row ).fid;
+      requestedFids << mEntries.at( row ).fid;
     }
   }
 
-  return feature;
+  if ( fids.isEmpty() )
+    return features;
+
+  QHash<QgsFeatureId, QgsFeature> featuresById;
+  QgsFeatureIterator iterator = mCurrentLayer->getFeatures( QgsFeatureRequest( requestedFids ) );
+  QgsFeature feature;
+  while ( iterator.nextFeature( feature ) )
+    featuresById.insert( feature.id(), feature );
+
+  features.reserve( fids.size() );
+  for ( const QgsFeatureId fid : qgis::as_const( fids ) )
+  {
+    if ( featuresById.contains( fid ) )
+      features << featuresById.value( fid );
+  }
+
+  return features;
 }
 
 void FeatureListModel::processReloadLayer()
 {
+  cancelReload();
+
+  beginResetModel();
   mEntries.clear();
+  mRowsByKey.clear();
+  mNullKeyRow = -1;
+  mRowsByFid.clear();
+  if ( mAddNull )
+    mEntries.append( Entry( QStringLiteral( "<i>NULL</i>" ), QVariant(), QgsFeatureId() ) );
+  endResetModel();
 
   if ( !mCurrentLayer )
+  {
+    emit isLoadingChanged();
     return;
+  }
 
-  QgsFeatureRequest request;
+  QgsFeatureRequest request = featureRequest();
   QgsExpressionContext context = mCurrentLayer->createExpressionContext();
   QgsExpression expression( mCurrentLayer->displayExpression() );
   expression.prepare( &context );
@@ -221,68 +512,198 @@ void FeatureListModel::processReloadLayer()
 
   referencedColumns << mDisplayValueField;
 
-  QgsFields fields = mCurrentLayer->fields();
+  request.setSubsetOfAttributes( referencedColumns, mCurrentLayer->fields() );
 
-  request.setSubsetOfAttributes( referencedColumns, fields );
+  // Changes to other fields do not affect the entries
+  mReferencedColumns = referencedColumns;
+  if ( request.filterExpression() )
+    mReferencedColumns.unite( request.filterExpression()->referencedColumns() );
 
-  if ( ! mFilterExpression.isEmpty()
-       && ( ! QgsValueRelationFieldFormatter::expressionRequiresFormScope( mFilterExpression )
-            || QgsValueRelationFieldFormatter::expressionIsUsable( mFilterExpression, mCurrentFormFeature )
-          ) )
+  if ( mPageSize > 0 )
   {
-    QgsExpression exp( mFilterExpression );
-    QgsExpressionContext filterContext = QgsExpressionContext( QgsExpressionContextUtils::globalProjectLayerScopes( mCurrentLayer ) );
+    mCanFetchMore = true;
+    mLastPageFeature = QgsFeature();
+    fetchMore( QModelIndex() );
+    return;
+  }
 
-    if ( mCurrentFormFeature.isValid( ) && QgsValueRelationFieldFormatter::expressionRequiresFormScope( mFilterExpression ) )
-      filterContext.appendScope( QgsExpressionContextUtils::formScope( mCurrentFormFeature ) );
+  mGatherer = new FeatureListGatherer( mCurrentLayer, request, mKeyField, mDisplayValueField, mOrderByValue );
 
-    request.setExpressionContext( filterContext );
-    request.setFilterExpression( mFilterExpression );
-  }
+  connect( mGatherer, &FeatureListGatherer::collectedEntries, this, &FeatureListModel::onEntriesCollected );
+  connect( mGatherer, &FeatureListGatherer::finished, this, &FeatureListModel::gathererThreadFinished );
 
-  int keyIndex = fields.indexOf( mKeyField );
-  int displayValueIndex = fields.indexOf( mDisplayValueField );
+  mGatherer->start();
+}
 
-  QgsFeatureIterator iterator = mCurrentLayer->getFeatures( request );
+void FeatureListModel::onEntriesCollected()
+{
+  //ignore spooky signals from ancestor threads
+  if ( sender() != mGatherer )
+    return;
 
-  QgsFeature feature;
+  const QList<Entry> entries = mGatherer->takeEntries();
+  if ( entries.isEmpty() )
+    return;
 
-  QList<Entry> entries;
+  const int from = mEntries.size();
+  beginInsertRows( QModelIndex(), from, from + entries.size() - 1 );
+  mEntries.append( entries );
+  indexKeys( from );
+  endInsertRows();
+}
 
-  if ( mAddNull )
-    entries.append( Entry( QStringLiteral( "<i>NULL</i>" ), QVariant(), QgsFeatureId() ) );
+void FeatureListModel::gathererThreadFinished()
+{
+  //ignore spooky signals from ancestor threads
+  if ( sender() != mGatherer )
+    return;
 
-  while ( iterator.nextFeature( feature ) )
+  if ( mPageSize > 0 )
   {
-    context.setFeature( feature );
-    if ( mDisplayValueField.isEmpty() )
-      entries.append( Entry( expression.evaluate( &context ).toString(), feature.attribute( keyIndex ), feature.id() ) );
-    else
-      entries.append( Entry( feature.attribute( displayValueIndex ).toString(), feature.attribute( keyIndex ), feature.id() ) );
+    // A short page is the last one
+    mCanFetchMore = mGatherer->featureCount() == mPageSize;
+    if ( mGatherer->featureCount() > 0 )
+      mLastPageFeature = mGatherer->lastFeature();
   }
 
-  if ( mOrderByValue )
+  mGatherer->deleteLater();
+  mGatherer = nullptr;
+  emit isLoadingChanged();
+}
+
+void FeatureListModel::reloadLayer()
+{
+  const bool wasLoading = isLoading();
+
+  // A pending reload makes the running one stale
+  cancelReload();
+  mReloadTimer.start();
+
+  if ( !wasLoading )
+    emit isLoadingChanged();
+}
+
+void FeatureListModel::cancelReload()
+{
+  if ( !mGatherer )
+    return;
+
+  // Send the gatherer thread to the graveyard:
+  //   forget about it, tell it to stop and delete when finished
+  disconnect( mGatherer, &FeatureListGatherer::collectedEntries, this, &FeatureListModel::onEntriesCollected );
+  disconnect( mGatherer, &FeatureListGatherer::finished, this, &FeatureListModel::gathererThreadFinished );
+  connect( mGatherer, &FeatureListGatherer::finished, mGatherer, &FeatureListGatherer::deleteLater );
+  mGatherer->stop();
+  mGatherer = nullptr;
+}
+
+bool FeatureListModel::isLoading() const
+{
+  return mReloadTimer.isActive() || mGatherer;
+}
+
+bool FeatureListModel::canFetchMore( const QModelIndex &parent ) const
+{
+  // One page at a time, the next one starts after the last feature of the previous one
+  return !parent.isValid() && mPageSize > 0 && mCanFetchMore && mCurrentLayer && !mGatherer;
+}
+
+void FeatureListModel::fetchMore( const QModelIndex &parent )
+{
+  if ( !canFetchMore( parent ) )
+    return;
+
+  const QString keyExpression = QgsExpression::quotedColumnRef( mKeyField );
+  const QString valueField = mOrderByValue ? pageOrderField() : QString();
+  const QString valueExpression = QgsExpression::quotedColumnRef( valueField );
+
+  QgsFeatureRequest::OrderBy orderBy;
+  if ( !valueField.isEmpty() )
+    orderBy << QgsFeatureRequest::OrderByClause( valueExpression, true, true );
+  orderBy << QgsFeatureRequest::OrderByClause( keyExpression, true, true );
+
+  QgsFeatureRequest request = featureRequest();
+  request.setOrderBy( orderBy );
+  request.setLimit( mPageSize );
+
+  // Keyset pagination, the next page starts after the last fetched feature
+  if ( mLastPageFeature.isValid() )
   {
-    std::sort( entries.begin(), entries.end(), []( const Entry & entry1, const Entry & entry2 )
+    QString after = QStringLiteral( "%1 > %2" ).arg( keyExpression, QgsExpression::quotedValue( mLastPageFeature.attribute( mKeyField ) ) );
+    if ( !valueField.isEmpty() )
     {
-      if ( entry1.key.isNull() )
-        return true;
-
-      if ( entry2.key.isNull() )
-        return false;
+      // Null values come first
+      const QVariant lastValue = mLastPageFeature.attribute( valueField );
+      if ( lastValue.isNull() )
+        after = QStringLiteral( "( %1 IS NULL AND %2 ) OR %1 IS NOT NULL" ).arg( valueExpression, after );
+      else
+        after = QStringLiteral( "%1 > %2 OR ( %1 = %2 AND %3 )" ).arg( valueExpression, QgsExpression::quotedValue( lastValue ), after );
+    }
 
-      return entry1.displayString.toLower() < entry2.displayString.toLower();
-    } );
+    const QString filter = request.filterExpression() ? request.filterExpression()->expression() : QString();
+    if ( filter.isEmpty() )
+    {
+      request.setExpressionContext( QgsExpressionContext( QgsExpressionContextUtils::globalProjectLayerScopes( mCurrentLayer ) ) );
+      request.setFilterExpression( after );
+    }
+    else
+    {
+      request.setFilterExpression( QStringLiteral( "(%1) AND (%2)" ).arg( filter, after ) );
+    }
   }
 
-  beginResetModel();
-  mEntries = entries;
-  endResetModel();
+  const bool wasLoading = isLoading();
+
+  // The request already orders the page, the gatherer hands it over as it comes
+  mGatherer = new FeatureListGatherer( mCurrentLayer, request, mKeyField, mDisplayValueField, false );
+
+  connect( mGatherer, &FeatureListGatherer::collectedEntries, this, &FeatureListModel::onEntriesCollected );
+  connect( mGatherer, &FeatureListGatherer::finished, this, &FeatureListModel::gathererThreadFinished );
+
+  mGatherer->start();
+
+  if ( !wasLoading )
+    emit isLoadingChanged();
 }
 
-void FeatureListModel::reloadLayer()
+QString FeatureListModel::pageOrderField() const
 {
-  mReloadTimer.start();
+  if ( !mDisplayValueField.isEmpty() )
+    return mDisplayValueField;
+
+  // Other display expressions cannot be compiled, providers would fetch and sort all features for each page
+  const QgsExpression expression( mCurrentLayer->displayExpression() );
+  return expression.isField() ? *expression.referencedColumns().constBegin() : QString();
+}
+
+int FeatureListModel::pageSize() const
+{
+  return mPageSize;
+}
+
+void FeatureListModel::setPageSize( int pageSize )
+{
+  if ( mPageSize == pageSize )
+    return;
+
+  mPageSize = pageSize;
+  reloadLayer();
+  emit pageSizeChanged();
+}
+
+QString FeatureListModel::searchTerm() const
+{
+  return mSearchTerm;
+}
+
+void FeatureListModel::setSearchTerm( const QString &searchTerm )
+{
+  if ( mSearchTerm == searchTerm )
+    return;
+
+  mSearchTerm = searchTerm;
+  reloadLayer();
+  emit searchTermChanged();
 }
 
 bool FeatureListModel::addNull() const
@@ -344,3 +765,78 @@ void FeatureListModel::setCurrentFormFeature( const QgsFeature &feature )
   reloadLayer();
   emit currentFormFeatureChanged();
 }
+
+FeatureListGatherer::FeatureListGatherer( QgsVectorLayer *layer, const QgsFeatureRequest &request, const QString &keyField, const QString &displayValueField, bool orderByValue )
+  : mSource( new QgsVectorLayerFeatureSource( layer ) )
+  , mRequest( request )
+  , mContext( layer->createExpressionContext() )
+  , mKeyIndex( layer->fields().indexOf( keyField ) )
+  , mDisplayValueIndex( layer->fields().indexOf( displayValueField ) )
+  , mOrderByValue( orderByValue )
+{
+  if ( displayValueField.isEmpty() )
+    mDisplayExpression = layer->displayExpression();
+}
+
+FeatureListGatherer::~FeatureListGatherer() = default;
+
+void FeatureListGatherer::run()
+{
+  QgsExpression expression( mDisplayExpression );
+  expression.prepare( &mContext );
+
+  QgsFeatureIterator iterator = mSource->getFeatures( mRequest );
+
+  QgsFeature feature;
+  QList<FeatureListModel::Entry> entries;
+  while ( iterator.nextFeature( feature ) )
+  {
+    if ( mWasCanceled )
+      return;
+
+    mLastFeature = feature;
+    ++mFeatureCount;
+
+    if ( mDisplayExpression.isEmpty() )
+    {
+      entries.append( FeatureListModel::Entry( feature.attribute( mDisplayValueIndex ).toString(), feature.attribute( mKeyIndex ), feature.id() ) );
+    }
+    else
+    {
+      mContext.setFeature( feature );
+      entries.append( FeatureListModel::Entry( expression.evaluate( &mContext ).toString(), feature.attribute( mKeyIndex ), feature.id() ) );
+    }
+
+    // Ordered entries can only be handed over once all are known
+    if ( !mOrderByValue && entries.size() >= CHUNK_SIZE )
+    {
+      publish( entries );
+      entries.clear();
+    }
+  }
+
+  if ( mOrderByValue )
+  {
+    std::sort( entries.begin(), entries.end(), &FeatureListModel::entryLessThan );
+  }
+
+  if ( !entries.isEmpty() && !mWasCanceled )
+    publish( entries );
+}
+
+QList<FeatureListModel::Entry> FeatureListGatherer::takeEntries()
+{
+  QMutexLocker locker( &mMutex );
+  QList<FeatureListModel::Entry> entries;
+  entries.swap( mEntries );
+  return entries;
+}
+
+void FeatureListGatherer::publish( const QList<FeatureListModel::Entry> &entries )
+{
+  {
+    QMutexLocker locker( &mMutex );
+    mEntries.append( entries );
+  }
+  emit collectedEntries();
+}
@@ -17,17 +17,33 @@
 #define FEATURELISTMODEL_H
 
 #include <QAbstractItemModel>
+#include <QMutex>
+#include <QThread>
 #include <QTimer>
 
+#include <qgsexpressioncontext.h>
 #include <qgsfeature.h>
+#include <qgsfeaturerequest.h>
+
+#include <atomic>
+#include <memory>
 
 class QgsVectorLayer;
+class QgsVectorLayerFeatureSource;
+class FeatureListGatherer;
 
 /**
  * Provides access to a list of features from a layer.
  * For each feature, the display expression is exposed as DisplayRole
  * and a keyField as KeyFieldRole for a unique identifier.
  * If a displayValueField is set it replaces the display expression of the layer.
+ *
+ * The features are fetched from a snapshot of the layer in a separate thread and
+ * appended to the model in chunks while loading.
+ *
+ * If a pageSize is set, the model only holds the pages fetched so far instead. Views request
+ * the next page with fetchMore() when scrolling to the end of the list, it is fetched in a
+ * separate thread as well.
  */
 class FeatureListModel : public QAbstractItemModel
 {
@@ -66,6 +82,21 @@ class FeatureListModel : public QAbstractItemModel
       **/
     Q_PROPERTY( QgsFeature currentFormFeature READ currentFormFeature WRITE setCurrentFormFeature NOTIFY currentFormFeatureChanged )
 
+    /**
+      * Whether the features are being loaded, the model may not contain all of them yet
+      */
+    Q_PROPERTY( bool isLoading READ isLoading NOTIFY isLoadingChanged )
+
+    /**
+      * Number of features fetched at once when scrolling, 0 to load all features
+      */
+    Q_PROPERTY( int pageSize READ pageSize WRITE setPageSize NOTIFY pageSizeChanged )
+
+    /**
+      * Text the display values must contain, case insensitive. Empty string if no search is applied.
+      */
+    Q_PROPERTY( QString searchTerm READ searchTerm WRITE setSearchTerm NOTIFY searchTermChanged )
+
   public:
     enum FeatureListRoles
     {
@@ -76,12 +107,15 @@ class FeatureListModel : public QAbstractItemModel
     Q_ENUM( FeatureListRoles )
 
     explicit FeatureListModel( QObject *parent = nullptr );
+    ~FeatureListModel() override;
 
     virtual QModelIndex index( int row, int column, const QModelIndex &parent ) const override;
     virtual QModelIndex parent( const QModelIndex &child ) const override;
     virtual int rowCount( const QModelIndex &parent ) const override;
     virtual int columnCount( const QModelIndex &parent ) const override;
     virtual QVariant data( const QModelIndex &index, int role ) const override;
+    virtual bool canFetchMore( const QModelIndex &parent ) const override;
+    virtual void fetchMore( const QModelIndex &parent ) override;
 
     Q_INVOKABLE QVariant dataFromRowIndex( int row, int role ) { return data( index( row, 0, QModelIndex() ), role ); }
 
@@ -90,6 +124,12 @@ class FeatureListModel : public QAbstractItemModel
      */
     Q_INVOKABLE QgsFeature getFeatureFromKeyValue( const QVariant &value ) const;
 
+    /**
+     * Returns the first feature matching each of the key \a values, fetched with a single request.
+     * Values without a matching entry are skipped.
+     */
+    Q_INVOKABLE QList<QgsFeature> getFeaturesFromKeyValues( const QVariantList &values ) const;
+
     virtual QHash<int, QByteArray> roleNames() const override;
 
     QgsVectorLayer *currentLayer() const;
@@ -103,9 +143,16 @@ class FeatureListModel : public QAbstractItemModel
 
     /**
        * Get the row for a given key value.
+       * Unknown keys map to the NULL entry if addNull is set, unless a pageSize is set and
+       * the key may be on a page not fetched yet, in which case -1 is returned.
        */
     Q_INVOKABLE int findKey( const QVariant &key ) const;
 
+    /**
+       * Get the rows for the given key values, in the same order, as findKey() does.
+       */
+    Q_INVOKABLE QList<int> findKeys( const QVariantList &keys ) const;
+
     /**
        * Orders all the values alphabethically by their displayString.
        */
@@ -146,6 +193,35 @@ class FeatureListModel : public QAbstractItemModel
      */
     void setCurrentFormFeature( const QgsFeature &feature );
 
+    /**
+     * Whether the features are being loaded, the model may not contain all of them yet
+     */
+    bool isLoading() const;
+
+    /**
+     * Number of features fetched at once when scrolling, 0 to load all features.
+     */
+    int pageSize() const;
+
+    /**
+     * Sets the number of features fetched at once when scrolling, 0 to load all features.
+     * Pages are ordered by key, the key is expected to be unique. If orderByValue is set, they are ordered by
+     * the displayValueField or the field of a display expression consisting of a single field first, as the
+     * provider orders its values. Other display expressions cannot be ordered by the provider and are ignored.
+     */
+    void setPageSize( int pageSize );
+
+    /**
+     * Text the display values must contain, case insensitive. Empty string if no search is applied.
+     */
+    QString searchTerm() const;
+
+    /**
+     * Sets the text the display values must contain. The search is part of the feature request,
+     * so that providers can apply it.
+     */
+    void setSearchTerm( const QString &searchTerm );
+
   signals:
     void currentLayerChanged();
     void keyFieldChanged();
@@ -154,16 +230,21 @@ class FeatureListModel : public QAbstractItemModel
     void addNullChanged();
     void filterExpressionChanged();
     void currentFormFeatureChanged();
+    void isLoadingChanged();
+    void pageSizeChanged();
+    void searchTermChanged();
 
   private slots:
-    void onFeatureAdded();
+    void onFeatureAdded( QgsFeatureId fid );
     void onAttributeValueChanged( QgsFeatureId fid, int idx, const QVariant &value );
-    void onFeatureDeleted();
+    void onFeatureDeleted( QgsFeatureId fid );
     /**
        * Reloads a layer. This will normally be triggered
        * by \see reloadLayer and should not be called directly.
        */
     void processReloadLayer();
+    void onEntriesCollected();
+    void gathererThreadFinished();
 
   private:
     struct Entry
@@ -190,9 +271,46 @@ class FeatureListModel : public QAbstractItemModel
        */
     void reloadLayer();
 
+    //! Stops a running load, the entries it collected so far stay in the model
+    void cancelReload();
+
+    //! Returns the first row with the \a key, -1 if there is none
+    int keyRow( const QVariant &key ) const;
+    //! Adds the keys and feature ids of the entries from row \a from on to the index
+    void indexKeys( int from );
+    //! Removes the keys and feature ids of the entries from row \a from on from the index, before these rows move
+    void unindexKeys( int from );
+
+    //! The request for the features to list, without the subset of attributes
+    QgsFeatureRequest featureRequest() const;
+    //! The expression of the display values
+    QString displayExpression() const;
+    //! The field holding the display values to order pages by, empty if the display values are not a field
+    QString pageOrderField() const;
+    //! Builds the \a entry of the feature \a fid, returns false if the feature is not listed
+    bool entryForFeature( QgsFeatureId fid, Entry &entry ) const;
+    //! Returns the row of the feature \a fid, -1 if it is not listed
+    int featureRow( QgsFeatureId fid ) const;
+    //! Inserts the \a entry at its position
+    void insertEntry( const Entry &entry );
+    void removeEntry( int row );
+    //! Updates, inserts or removes the entry of the feature \a fid
+    void updateFeature( QgsFeatureId fid );
+
+    //! The order of entries if orderByValue is set, null keys first
+    static bool entryLessThan( const Entry &entry1, const Entry &entry2 );
+
     QgsVectorLayer *mCurrentLayer = nullptr;
 
     QList<Entry> mEntries;
+    //! First row of each non null key, by its string representation
+    QHash<QString, int> mRowsByKey;
+    //! First row with a null key, -1 if there is none
+    int mNullKeyRow = -1;
+    //! Row of each listed feature
+    QHash<QgsFeatureId, int> mRowsByFid;
+    //! Fields whose values are used by the entries, set on reload
+    QSet<QString> mReferencedColumns;
     QString mKeyField;
     QString mDisplayValueField;
     bool mOrderByValue = false;
@@ -201,6 +319,75 @@ class FeatureListModel : public QAbstractItemModel
     QgsFeature mCurrentFormFeature;
 
     QTimer mReloadTimer;
+    FeatureListGatherer *mGatherer = nullptr;
+    int mPageSize = 0;
+    QString mSearchTerm;
+    bool mCanFetchMore = false;
+    //! Last feature of the pages fetched so far, the next page starts after it
+    QgsFeature mLastPageFeature;
+
+    friend class FeatureListGatherer;
+};
+
+/**
+ * Collects the entries of a FeatureListModel from a snapshot of the layer.
+ * The entries are handed over in chunks, unless they need to be ordered.
+ */
+class FeatureListGatherer : public QThread
+{
+    Q_OBJECT
+
+  public:
+    //! Number of entries collected before they are handed over to the model
+    static const int CHUNK_SIZE = 500;
+
+    /**
+     * Creates a gatherer for the features of \a layer matching \a request.
+     * Must be called from the thread of the layer.
+     */
+    FeatureListGatherer( QgsVectorLayer *layer, const QgsFeatureRequest &request, const QString &keyField, const QString &displayValueField, bool orderByValue );
+    ~FeatureListGatherer() override;
+
+    void run() override;
+
+    //! Informs the gatherer to immediately stop collecting values
+    void stop() { mWasCanceled = true; }
+
+    //! \returns true if collection was canceled before completion
+    bool wasCanceled() const { return mWasCanceled; }
+
+    //! Takes the entries collected since the last call
+    QList<FeatureListModel::Entry> takeEntries();
+
+    //! Returns the number of features collected, once the gatherer finished
+    int featureCount() const { return mFeatureCount; }
+
+    //! Returns the last feature collected, once the gatherer finished
+    QgsFeature lastFeature() const { return mLastFeature; }
+
+  signals:
+
+    /**
+     * Emitted when a chunk of entries has been collected
+     */
+    void collectedEntries();
+
+  private:
+    void publish( const QList<FeatureListModel::Entry> &entries );
+
+    std::unique_ptr<QgsVectorLayerFeatureSource> mSource;
+    QgsFeatureRequest mRequest;
+    QgsExpressionContext mContext;
+    QString mDisplayExpression;
+    int mKeyIndex = -1;
+    int mDisplayValueIndex = -1;
+    bool mOrderByValue = false;
+
+    QMutex mMutex;
+    QList<FeatureListModel::Entry> mEntries;
+    std::atomic<bool> mWasCanceled { false };
+    int mFeatureCount = 0;
+    QgsFeature mLastFeature;
 };
 
 #endif // FEATURELISTMODEL_H
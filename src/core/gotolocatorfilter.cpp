@@ -24,6 +24,7 @@
 #include <qgspoint.h>
 #include <qgsproject.h>
 
+#include "coordinatetransformcache.h"
 #include "locatormodelsuperbridge.h"
 #include "qgsquickmapsettings.h"
 
@@ -110,7 +111,7 @@ void GotoLocatorFilter::fetchResults( const QString &string, const QgsLocatorCon
     {
       if ( currentCrs != wgs84Crs )
       {
-        QgsCoordinateTransform transform( wgs84Crs, currentCrs, QgsProject::instance()->transformContext() );
+        const QgsCoordinateTransform transform = CoordinateTransformCache::instance()->transform( wgs84Crs, currentCrs );
         QgsPointXY transformedPoint;
         try
         {
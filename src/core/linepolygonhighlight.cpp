@@ -21,6 +21,7 @@
 
 #include "qgsgeometrywrapper.h"
 #include "qgssggeometry.h"
+#include "qgsquickmaptransform.h"
 
 
 LinePolygonHighlight::LinePolygonHighlight( QQuickItem *parent )
@@ -35,23 +36,24 @@ QSGNode *LinePolygonHighlight::updatePaintNode( QSGNode *n, QQuickItem::UpdatePa
   if ( mDirty && mMapSettings )
   {
     delete n;
-    n = new QSGNode;
+    n = mLocalOrigin ? new QSGTransformNode : new QSGNode;
 
     QgsGeometry geometry;
+    QVector<QgsPointXY> triangles;
+    mLevelOfDetail = QgsSGTessellator::levelOfDetail( mMapSettings->mapUnitsPerPoint() );
     if ( mGeometry )
     {
       Q_ASSERT( mGeometry->qgsGeometry().type() != QgsWkbTypes::PointGeometry );
 
-      geometry = QgsGeometry( mGeometry->qgsGeometry() );
-
-      if ( mMapSettings )
-      {
-        QgsCoordinateTransform ct( mGeometry->crs(), mMapSettings->destinationCrs(), QgsProject::instance()->transformContext() );
-        geometry.transform( ct );
-      }
+      // Re-highlighting a geometry at a similar scale reuses its transformed copy and tessellation
+      const QgsSGTessellator::Tessellation tessellation = QgsSGTessellator::instance()->tessellation( mGeometry->qgsGeometry(), mGeometry->crs(), mMapSettings->destinationCrs(), QgsProject::instance()->transformContext(), mLevelOfDetail );
+      geometry = tessellation.geometry;
+      triangles = tessellation.triangles;
     }
 
-    QgsSGGeometry *gn = new QgsSGGeometry( geometry, mColor, mWidth );
+    mOrigin = mLocalOrigin && !geometry.isNull() ? geometry.boundingBox().center() : QgsPointXY( 0, 0 );
+
+    QgsSGGeometry *gn = new QgsSGGeometry( geometry, triangles, mColor, mWidth, mOrigin );
     gn->setFlag( QSGNode::OwnedByParent );
     n->appendChildNode( gn );
 
@@ -60,6 +62,9 @@ QSGNode *LinePolygonHighlight::updatePaintNode( QSGNode *n, QQuickItem::UpdatePa
     emit updated();
   }
 
+  if ( n && mLocalOrigin && mMapSettings )
+    static_cast<QSGTransformNode *>( n )->setMatrix( QgsQuickMapTransform::matrix( mMapSettings, mOrigin ) );
+
   return n;
 }
 
@@ -97,6 +102,23 @@ void LinePolygonHighlight::setColor( const QColor &color )
   update();
 }
 
+bool LinePolygonHighlight::localOrigin() const
+{
+  return mLocalOrigin;
+}
+
+void LinePolygonHighlight::setLocalOrigin( bool localOrigin )
+{
+  if ( mLocalOrigin == localOrigin )
+    return;
+
+  mLocalOrigin = localOrigin;
+  mDirty = true;
+
+  emit localOriginChanged();
+  update();
+}
+
 QgsQuickMapSettings *LinePolygonHighlight::mapSettings() const
 {
   return mMapSettings;
@@ -108,11 +130,17 @@ void LinePolygonHighlight::setMapSettings( QgsQuickMapSettings *mapSettings )
     return;
 
   if ( mMapSettings )
+  {
     disconnect( mMapSettings, &QgsQuickMapSettings::destinationCrsChanged, this, &LinePolygonHighlight::mapCrsChanged );
+    disconnect( mMapSettings, &QgsQuickMapSettings::visibleExtentChanged, this, &LinePolygonHighlight::visibleExtentChanged );
+    disconnect( mMapSettings, &QgsQuickMapSettings::mapUnitsPerPointChanged, this, &LinePolygonHighlight::mapUnitsPerPointChanged );
+  }
 
   mMapSettings = mapSettings;
 
   connect( mMapSettings, &QgsQuickMapSettings::destinationCrsChanged, this, &LinePolygonHighlight::mapCrsChanged );
+  connect( mMapSettings, &QgsQuickMapSettings::visibleExtentChanged, this, &LinePolygonHighlight::visibleExtentChanged );
+  connect( mMapSettings, &QgsQuickMapSettings::mapUnitsPerPointChanged, this, &LinePolygonHighlight::mapUnitsPerPointChanged );
 
   emit mapSettingsChanged();
 }
@@ -123,6 +151,19 @@ void LinePolygonHighlight::mapCrsChanged()
   update();
 }
 
+void LinePolygonHighlight::visibleExtentChanged()
+{
+  // Only the transform of the node changes, the vertices are kept
+  if ( mLocalOrigin )
+    update();
+}
+
+void LinePolygonHighlight::mapUnitsPerPointChanged()
+{
+  if ( QgsSGTessellator::levelOfDetail( mMapSettings->mapUnitsPerPoint() ) != mLevelOfDetail )
+    makeDirty();
+}
+
 void LinePolygonHighlight::makeDirty()
 {
   mDirty = true;
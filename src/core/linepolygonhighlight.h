@@ -20,6 +20,10 @@
 
 #include "qgsquickmapsettings.h"
 
+#include <qgspointxy.h>
+
+#include "qgssgtessellator.h"
+
 class QgsGeometryWrapper;
 class QgsGeometry;
 
@@ -27,6 +31,9 @@ class QgsGeometry;
 /**
  * LocatorHighlight allows highlighting geometries
  * on the canvas for the specific needs of the locator.
+ *
+ * Lines and polygons are simplified to the level of detail of the current scale,
+ * a new simplification is only built when zooming crosses into another level.
  */
 class LinePolygonHighlight : public QQuickItem
 {
@@ -36,6 +43,8 @@ class LinePolygonHighlight : public QQuickItem
     Q_PROPERTY( float width READ width WRITE setWidth NOTIFY widthChanged )
     Q_PROPERTY( QgsQuickMapSettings *mapSettings READ mapSettings WRITE setMapSettings NOTIFY mapSettingsChanged )
     Q_PROPERTY( QgsGeometryWrapper *geometry READ geometry WRITE setGeometry NOTIFY qgsGeometryChanged )
+    //! Stores the vertices relative to the center of the geometry and transforms them itself, the item must then not be placed under a MapTransform
+    Q_PROPERTY( bool localOrigin READ localOrigin WRITE setLocalOrigin NOTIFY localOriginChanged )
 
   public:
     explicit LinePolygonHighlight( QQuickItem *parent = nullptr );
@@ -52,15 +61,21 @@ class LinePolygonHighlight : public QQuickItem
     float width() const;
     void setWidth( float width );
 
+    bool localOrigin() const;
+    void setLocalOrigin( bool localOrigin );
+
   signals:
     void colorChanged();
     void widthChanged();
     void mapSettingsChanged();
     void qgsGeometryChanged();
+    void localOriginChanged();
     void updated();
 
   private slots:
     void mapCrsChanged();
+    void visibleExtentChanged();
+    void mapUnitsPerPointChanged();
     void makeDirty();
 
   private:
@@ -69,6 +84,9 @@ class LinePolygonHighlight : public QQuickItem
     QColor mColor;
     float mWidth = 0;
     bool mDirty = false;
+    bool mLocalOrigin = false;
+    int mLevelOfDetail = QgsSGTessellator::FullDetail;
+    QgsPointXY mOrigin;
     QgsQuickMapSettings *mMapSettings = nullptr;
     QgsGeometryWrapper *mGeometry = nullptr;
 };
@@ -28,6 +28,8 @@
 #include "featureutils.h"
 
 #include <QDebug>
+#include <QSet>
+#include <algorithm>
 
 MultiFeatureListModelBase::MultiFeatureListModelBase( QObject *parent )
   :  QAbstractItemModel( parent )
@@ -37,6 +39,12 @@ MultiFeatureListModelBase::MultiFeatureListModelBase( QObject *parent )
 
 void MultiFeatureListModelBase::setFeatures( const QMap<QgsVectorLayer *, QgsFeatureRequest> requests )
 {
+  // Features found again keep their selection
+  QSet< QPair< QgsVectorLayer *, QgsFeatureId > > selectedKeys;
+  for ( const auto &pair : selectedItems() )
+    selectedKeys.insert( qMakePair( pair.first, pair.second.id() ) );
+  const int previousSelectedCount = mSelectedCount;
+
   beginResetModel();
 
   mFeatures.clear();
@@ -56,42 +64,80 @@ void MultiFeatureListModelBase::setFeatures( const QMap<QgsVectorLayer *, QgsFea
     }
   }
 
+  indexFeatures();
+
+  mSelectedRows = QBitArray( mFeatures.size() );
+  mSelectedCount = 0;
+  if ( !selectedKeys.isEmpty() )
+  {
+    for ( int row = 0; row < mFeatures.size(); ++row )
+    {
+      if ( selectedKeys.contains( qMakePair( mFeatures.at( row ).first, mFeatures.at( row ).second.id() ) ) )
+      {
+        mSelectedRows.setBit( row );
+        ++mSelectedCount;
+      }
+    }
+  }
+
   endResetModel();
+
+  if ( mSelectedCount != previousSelectedCount )
+    emit selectedCountChanged();
 }
 
 void MultiFeatureListModelBase::appendFeatures( const QList<IdentifyTool::IdentifyResult> &results )
 {
-  beginInsertRows( QModelIndex(), mFeatures.count(), mFeatures.count() + results.count() - 1 );
+  // While features are selected, new features are added to the selection and features found again are unselected
+  const bool selecting = mSelectedCount > 0;
 
+  QList< QPair< QgsVectorLayer *, QgsFeature > > newItems;
+  QSet< QPair< QgsVectorLayer *, QgsFeatureId > > newKeys;
+  QList<int> unselectedRows;
   for ( const IdentifyTool::IdentifyResult &result : results )
   {
     QgsVectorLayer *layer = qobject_cast<QgsVectorLayer *>( result.layer );
-    QPair<QgsVectorLayer *, QgsFeature> item( layer, result.feature );
-    if ( !mFeatures.contains( item ) )
+    const QPair< QgsVectorLayer *, QgsFeatureId > key( layer, result.feature.id() );
+    const int row = mFeatureRows.value( key, -1 );
+    if ( row < 0 )
     {
-      mFeatures.append( item );
+      if ( newKeys.contains( key ) )
+        continue;
+
+      newKeys.insert( key );
+      newItems.append( QPair<QgsVectorLayer *, QgsFeature>( layer, result.feature ) );
       connect( layer, &QObject::destroyed, this, &MultiFeatureListModelBase::layerDeleted, Qt::UniqueConnection );
       connect( layer, &QgsVectorLayer::featureDeleted, this, &MultiFeatureListModelBase::featureDeleted, Qt::UniqueConnection );
       connect( layer, &QgsVectorLayer::attributeValueChanged, this, &MultiFeatureListModelBase::attributeValueChanged, Qt::UniqueConnection );
       connect( layer, &QgsVectorLayer::geometryChanged, this, &MultiFeatureListModelBase::geometryChanged, Qt::UniqueConnection );
-
-      if ( !mSelectedFeatures.isEmpty() )
-      {
-        mSelectedFeatures.append( item );
-      }
     }
-    else if ( mSelectedFeatures.size() > 1 && mSelectedFeatures.contains( item ) )
+    else if ( mSelectedCount > 1 && mSelectedRows.testBit( row ) )
     {
-      int row = mFeatures.indexOf( item );
-      mSelectedFeatures.removeAll( item );
+      mSelectedRows.clearBit( row );
+      --mSelectedCount;
+      unselectedRows << row;
+    }
+  }
 
-      QModelIndex index = createIndex( row, 0 );
-      emit dataChanged( index, index, QVector<int>() << MultiFeatureListModel::FeatureSelectedRole );
+  if ( !newItems.isEmpty() )
+  {
+    const int first = mFeatures.count();
+    beginInsertRows( QModelIndex(), first, first + newItems.count() - 1 );
+    mFeatures.append( newItems );
+    for ( int row = first; row < mFeatures.count(); ++row )
+      mFeatureRows.insert( qMakePair( mFeatures.at( row ).first, mFeatures.at( row ).second.id() ), row );
+    mSelectedRows.resize( mFeatures.count() );
+    if ( selecting )
+    {
+      mSelectedRows.fill( true, first, mFeatures.count() );
+      mSelectedCount += newItems.count();
     }
+    endInsertRows();
   }
-  endInsertRows();
 
-  if ( !mSelectedFeatures.isEmpty() )
+  emitDataChanged( unselectedRows, QVector<int>() << MultiFeatureListModel::FeatureSelectedRole );
+
+  if ( selecting )
   {
     emit selectedCountChanged();
   }
@@ -104,39 +150,37 @@ void MultiFeatureListModelBase::clear( const bool keepSelected )
     return;
 
   beginResetModel();
-  mFeatures.clear();
   if ( keepSelected )
   {
-    mFeatures = mSelectedFeatures;
+    mFeatures = selectedItems();
+    mSelectedRows = QBitArray( mFeatures.size(), true );
+    mSelectedCount = mFeatures.size();
   }
   else
   {
-    mSelectedFeatures.clear();
+    mFeatures.clear();
+    mSelectedRows.clear();
+    mSelectedCount = 0;
   }
+  indexFeatures();
   endResetModel();
 }
 
 void MultiFeatureListModelBase::clearSelection()
 {
-  if ( mSelectedFeatures.isEmpty() )
+  if ( mSelectedCount == 0 )
   {
     return;
   }
 
-  mSelectedFeatures.clear();
+  unselectAll();
   emit selectedCountChanged();
 }
 
 void MultiFeatureListModelBase::toggleSelectedItem( int item )
 {
-  if ( !mSelectedFeatures.contains( mFeatures.at( item ) ) )
-  {
-    mSelectedFeatures << mFeatures.at( item );
-  }
-  else
-  {
-    mSelectedFeatures.removeAll( mFeatures.at( item ) );
-  }
+  mSelectedRows.toggleBit( item );
+  mSelectedCount += mSelectedRows.testBit( item ) ? 1 : -1;
 
   QModelIndex modifiedIndex = index( item, 0 );
   emit dataChanged( modifiedIndex, modifiedIndex, QVector<int>() << MultiFeatureListModel::FeatureSelectedRole );
@@ -146,13 +190,78 @@ void MultiFeatureListModelBase::toggleSelectedItem( int item )
 QList<QgsFeature> MultiFeatureListModelBase::selectedFeatures()
 {
   QList<QgsFeature> features;
-  for ( const QPair< QgsVectorLayer *, QgsFeature > &pair : mSelectedFeatures )
+  for ( const QPair< QgsVectorLayer *, QgsFeature > &pair : selectedItems() )
   {
     features << pair.second;
   }
   return features;
 }
 
+int MultiFeatureListModelBase::featureRow( QgsVectorLayer *layer, QgsFeatureId fid ) const
+{
+  return mFeatureRows.value( qMakePair( layer, fid ), -1 );
+}
+
+void MultiFeatureListModelBase::indexFeatures()
+{
+  mFeatureRows.clear();
+  mFeatureRows.reserve( mFeatures.size() );
+  for ( int row = 0; row < mFeatures.size(); ++row )
+    mFeatureRows.insert( qMakePair( mFeatures.at( row ).first, mFeatures.at( row ).second.id() ), row );
+}
+
+QList< QPair< QgsVectorLayer *, QgsFeature > > MultiFeatureListModelBase::selectedItems() const
+{
+  QList< QPair< QgsVectorLayer *, QgsFeature > > items;
+  items.reserve( mSelectedCount );
+  for ( int row = 0; row < mSelectedRows.size() && items.size() < mSelectedCount; ++row )
+  {
+    if ( mSelectedRows.testBit( row ) )
+      items << mFeatures.at( row );
+  }
+  return items;
+}
+
+QgsVectorLayer *MultiFeatureListModelBase::selectionLayer() const
+{
+  for ( int row = 0; row < mSelectedRows.size() && mSelectedCount > 0; ++row )
+  {
+    if ( mSelectedRows.testBit( row ) )
+      return mFeatures.at( row ).first;
+  }
+  return nullptr;
+}
+
+void MultiFeatureListModelBase::unselectAll()
+{
+  QList<int> rows;
+  rows.reserve( mSelectedCount );
+  for ( int row = 0; row < mSelectedRows.size() && rows.size() < mSelectedCount; ++row )
+  {
+    if ( mSelectedRows.testBit( row ) )
+      rows << row;
+  }
+
+  mSelectedRows.fill( false );
+  mSelectedCount = 0;
+  emitDataChanged( rows, QVector<int>() << MultiFeatureListModel::FeatureSelectedRole );
+}
+
+void MultiFeatureListModelBase::emitDataChanged( QList<int> rows, const QVector<int> &roles )
+{
+  std::sort( rows.begin(), rows.end() );
+  int first = 0;
+  while ( first < rows.size() )
+  {
+    int last = first;
+    while ( last + 1 < rows.size() && rows.at( last + 1 ) == rows.at( last ) + 1 )
+      ++last;
+
+    emit dataChanged( index( rows.at( first ), 0 ), index( rows.at( last ), 0 ), roles );
+    first = last + 1;
+  }
+}
+
 QHash<int, QByteArray> MultiFeatureListModelBase::roleNames() const
 {
   QHash<int, QByteArray> roleNames;
@@ -213,7 +322,7 @@ QVariant MultiFeatureListModelBase::data( const QModelIndex &index, int role ) c
       return feature->second.id();
 
     case MultiFeatureListModel::FeatureSelectedRole:
-      return mSelectedFeatures.contains( mFeatures.at( index.row() ) );
+      return mSelectedRows.testBit( index.row() );
 
     case MultiFeatureListModel::FeatureRole:
       return feature->second;
@@ -254,29 +363,92 @@ bool MultiFeatureListModelBase::removeRows( int row, int count, const QModelInde
   if ( !count )
     return true;
 
-  int i = 0;
-  QMutableListIterator<QPair< QgsVectorLayer *, QgsFeature >> it( mFeatures );
-  while ( i < row )
-  {
-    it.next();
-    i++;
-  }
-
   int last = row + count - 1;
 
   beginRemoveRows( parent, row, last );
-  while ( i <= last )
+  for ( int i = row; i <= last; ++i )
+    mFeatureRows.remove( qMakePair( mFeatures.at( i ).first, mFeatures.at( i ).second.id() ) );
+  mFeatures.erase( mFeatures.begin() + row, mFeatures.begin() + last + 1 );
+  for ( int i = row; i < mFeatures.size(); ++i )
+    mFeatureRows.insert( qMakePair( mFeatures.at( i ).first, mFeatures.at( i ).second.id() ), i );
+
+  // Following rows move up, along with their selection
+  const int previousSelectedCount = mSelectedCount;
+  for ( int i = row; i <= last; ++i )
   {
-    it.next();
-    it.remove();
-    i++;
+    if ( mSelectedRows.testBit( i ) )
+      --mSelectedCount;
   }
+  for ( int i = row; i < mFeatures.size(); ++i )
+    mSelectedRows.setBit( i, mSelectedRows.testBit( i + count ) );
+  mSelectedRows.resize( mFeatures.size() );
   endRemoveRows();
   emit countChanged();
 
+  if ( mSelectedCount != previousSelectedCount )
+    emit selectedCountChanged();
+
   return true;
 }
 
+void MultiFeatureListModelBase::removeFeatureRows( QList<int> rows )
+{
+  if ( rows.isEmpty() )
+    return;
+
+  std::sort( rows.begin(), rows.end() );
+  rows.erase( std::unique( rows.begin(), rows.end() ), rows.end() );
+
+  if ( rows.constLast() - rows.constFirst() == rows.size() - 1 )
+  {
+    removeRows( rows.constFirst(), rows.size() );
+    return;
+  }
+
+  // Scattered rows are compacted in a single pass, instead of moving the following rows once per removed row
+  const int previousSelectedCount = mSelectedCount;
+  beginResetModel();
+  int removed = 0;
+  auto nextRemoved = rows.constBegin();
+  for ( int row = 0; row < mFeatures.size(); ++row )
+  {
+    if ( nextRemoved != rows.constEnd() && *nextRemoved == row )
+    {
+      if ( mSelectedRows.testBit( row ) )
+        --mSelectedCount;
+      ++removed;
+      ++nextRemoved;
+    }
+    else if ( removed > 0 )
+    {
+      mFeatures[row - removed] = mFeatures.at( row );
+      mSelectedRows.setBit( row - removed, mSelectedRows.testBit( row ) );
+    }
+  }
+  mFeatures.erase( mFeatures.end() - removed, mFeatures.end() );
+  mSelectedRows.resize( mFeatures.size() );
+  indexFeatures();
+  endResetModel();
+  emit countChanged();
+
+  if ( mSelectedCount != previousSelectedCount )
+    emit selectedCountChanged();
+}
+
+void MultiFeatureListModelBase::removeDeferredRows()
+{
+  mRemovalsDeferred = false;
+
+  QList<int> rows;
+  rows.swap( mDeferredRemovedRows );
+  if ( rows.isEmpty() )
+    return;
+
+  unselectAll();
+  emit selectedCountChanged();
+  removeFeatureRows( rows );
+}
+
 int MultiFeatureListModelBase::count() const
 {
   return mFeatures.size();
@@ -284,25 +456,25 @@ int MultiFeatureListModelBase::count() const
 
 int MultiFeatureListModelBase::selectedCount() const
 {
-  return mSelectedFeatures.size();
+  return mSelectedCount;
 }
 
 bool MultiFeatureListModelBase::canEditAttributesSelection()
 {
-  if ( mSelectedFeatures.isEmpty() )
+  QgsVectorLayer *vlayer = selectionLayer();
+  if ( !vlayer )
     return false;
 
-  QgsVectorLayer *vlayer = mSelectedFeatures[0].first;
   return !vlayer->readOnly() &&
          ( vlayer->dataProvider()->capabilities() & QgsVectorDataProvider::ChangeAttributeValues );
 }
 
 bool MultiFeatureListModelBase::canMergeSelection()
 {
-  if ( mSelectedFeatures.isEmpty()  )
+  QgsVectorLayer *vlayer = selectionLayer();
+  if ( !vlayer )
     return false;
 
-  QgsVectorLayer *vlayer = mSelectedFeatures[0].first;
   return !vlayer->readOnly() && QgsWkbTypes::isMultiType( vlayer->wkbType() ) &&
          ( vlayer->dataProvider()->capabilities() & QgsVectorDataProvider::DeleteFeatures ) &&
          ( vlayer->dataProvider()->capabilities() & QgsVectorDataProvider::ChangeGeometries ) &&
@@ -311,10 +483,10 @@ bool MultiFeatureListModelBase::canMergeSelection()
 
 bool MultiFeatureListModelBase::canDeleteSelection()
 {
-  if ( mSelectedFeatures.isEmpty() )
+  QgsVectorLayer *vlayer = selectionLayer();
+  if ( !vlayer )
     return false;
 
-  QgsVectorLayer *vlayer = mSelectedFeatures[0].first;
   return !vlayer->readOnly() &&
          ( vlayer->dataProvider()->capabilities() & QgsVectorDataProvider::DeleteFeatures ) &&
          !vlayer->customProperty( QStringLiteral( "QFieldSync/is_geometry_locked" ), false ).toBool();
@@ -325,7 +497,7 @@ bool MultiFeatureListModelBase::mergeSelection()
   if ( !canMergeSelection() )
     return false;
 
-  QList< QPair< QgsVectorLayer *, QgsFeature > > selectedFeatures = mSelectedFeatures;
+  QList< QPair< QgsVectorLayer *, QgsFeature > > selectedFeatures = selectedItems();
   QgsVectorLayer *vlayer = selectedFeatures[0].first;
   bool isSuccess = true;
   QgsGeometry combinedGeometry;
@@ -363,6 +535,8 @@ bool MultiFeatureListModelBase::mergeSelection()
 
     if ( isSuccess )
     {
+      // The deleted features leave the model at once
+      mRemovalsDeferred = true;
       selectedFeatures.removeFirst();
       for ( const auto &pair : qgis::as_const( selectedFeatures ) )
       {
@@ -385,9 +559,11 @@ bool MultiFeatureListModelBase::mergeSelection()
       if ( !vlayer->rollBack() )
         QgsMessageLog::logMessage( tr( "Cannot rollback layer changes in layer %1" ).arg( vlayer->name() ), "QField", Qgis::Critical );
     }
+
+    removeDeferredRows();
   }
 
-  mSelectedFeatures.clear();
+  unselectAll();
   emit selectedCountChanged();
 
   return isSuccess;
@@ -505,15 +681,17 @@ bool MultiFeatureListModelBase::deleteSelection()
   if ( !canDeleteSelection() )
     return false;
 
-  QgsVectorLayer *vlayer = mSelectedFeatures[0].first;
+  QgsVectorLayer *vlayer = selectionLayer();
   if ( !vlayer->startEditing() )
   {
     QgsMessageLog::logMessage( tr( "Cannot start editing" ), "QField", Qgis::Warning );
     return false;
   }
 
-  const QList< QPair< QgsVectorLayer *, QgsFeature > > selectedFeatures = mSelectedFeatures;
+  const QList< QPair< QgsVectorLayer *, QgsFeature > > selectedFeatures = selectedItems();
   bool isSuccess = false;
+  // The deleted features leave the model at once
+  mRemovalsDeferred = true;
   for ( const auto &pair : selectedFeatures )
   {
     isSuccess = deleteFeature( pair.first, pair.second.id(), true );
@@ -533,6 +711,8 @@ bool MultiFeatureListModelBase::deleteSelection()
       QgsMessageLog::logMessage( tr( "Cannot rollback layer changes in layer %1" ).arg( vlayer->name() ), "QField", Qgis::Critical );
   }
 
+  removeDeferredRows();
+
   return isSuccess;
 }
 
@@ -567,7 +747,7 @@ void MultiFeatureListModelBase::layerDeleted( QObject *object )
 
   removeRows( firstRowToRemove, count );
 
-  mSelectedFeatures.clear();
+  unselectAll();
   emit selectedCountChanged();
 }
 
@@ -576,19 +756,19 @@ void MultiFeatureListModelBase::featureDeleted( QgsFeatureId fid )
   QgsVectorLayer *l = qobject_cast<QgsVectorLayer *>( sender() );
   Q_ASSERT( l );
 
-  mSelectedFeatures.clear();
-  emit selectedCountChanged();
-
-  int i = 0;
-  for ( auto it = mFeatures.constBegin(); it != mFeatures.constEnd(); it++ )
+  const int row = featureRow( l, fid );
+  if ( mRemovalsDeferred )
   {
-    if ( it->first == l && it->second.id() == fid )
-    {
-      removeRows( i, 1 );
-      break;
-    }
-    ++i;
+    if ( row >= 0 )
+      mDeferredRemovedRows << row;
+    return;
   }
+
+  unselectAll();
+  emit selectedCountChanged();
+
+  if ( row >= 0 )
+    removeRows( row, 1 );
 }
 
 void MultiFeatureListModelBase::attributeValueChanged( QgsFeatureId fid, int idx, const QVariant &value )
@@ -596,28 +776,14 @@ void MultiFeatureListModelBase::attributeValueChanged( QgsFeatureId fid, int idx
   QgsVectorLayer *l = qobject_cast<QgsVectorLayer *>( sender() );
   Q_ASSERT( l );
 
-  int i = 0;
-  for ( auto &pair : mFeatures )
-  {
-    if ( pair.first == l && pair.second.id() == fid )
-    {
-      pair.second.setAttribute( idx, value );
-      break;
-    }
-    i++;
-  }
+  const int row = featureRow( l, fid );
+  if ( row < 0 )
+    return;
 
-  QModelIndex indexChanged = createIndex( i, 1 );
-  emit dataChanged( indexChanged, indexChanged );
+  mFeatures[row].second.setAttribute( idx, value );
 
-  for ( auto &pair : mSelectedFeatures )
-  {
-    if ( pair.first == l && pair.second.id() == fid )
-    {
-      pair.second.setAttribute( idx, value );
-      break;
-    }
-  }
+  QModelIndex indexChanged = index( row, 0 );
+  emit dataChanged( indexChanged, indexChanged );
 }
 
 void MultiFeatureListModelBase::geometryChanged( QgsFeatureId fid, const QgsGeometry &geometry )
@@ -625,26 +791,12 @@ void MultiFeatureListModelBase::geometryChanged( QgsFeatureId fid, const QgsGeom
   QgsVectorLayer *l = qobject_cast<QgsVectorLayer *>( sender() );
   Q_ASSERT( l );
 
-  int i = 0;
-  for ( auto &pair : mFeatures )
-  {
-    if ( pair.first == l && pair.second.id() == fid )
-    {
-      pair.second.setGeometry( geometry );
-      break;
-    }
-    i++;
-  }
+  const int row = featureRow( l, fid );
+  if ( row < 0 )
+    return;
 
-  QModelIndex indexChanged = createIndex( i, 1 );
-  emit dataChanged( indexChanged, indexChanged, QVector<int>() << MultiFeatureListModel::GeometryRole << MultiFeatureListModel::FeatureSelectedRole );
+  mFeatures[row].second.setGeometry( geometry );
 
-  for ( auto &pair : mSelectedFeatures )
-  {
-    if ( pair.first == l && pair.second.id() == fid )
-    {
-      pair.second.setGeometry( geometry );
-      break;
-    }
-  }
+  QModelIndex indexChanged = index( row, 0 );
+  emit dataChanged( indexChanged, indexChanged, QVector<int>() << MultiFeatureListModel::GeometryRole << MultiFeatureListModel::FeatureSelectedRole );
 }
@@ -19,11 +19,16 @@
 #define MULTIFEATURELISTMODELBASE_H
 
 #include <QAbstractItemModel>
+#include <QBitArray>
 
 #include <qgsfeaturerequest.h>
 
 #include "identifytool.h"
 
+/**
+ * The features of a MultiFeatureListModel. Features are identified by their layer and id,
+ * the selection is a flag per row.
+ */
 class MultiFeatureListModelBase : public QAbstractItemModel
 {
     Q_OBJECT
@@ -116,7 +121,7 @@ class MultiFeatureListModelBase : public QAbstractItemModel
     void toggleSelectedItem( int item );
 
     /**
-     * Returns the list of currently selected features.
+     * Returns the list of currently selected features, in the order of the rows.
      */
     QList<QgsFeature> selectedFeatures();
 
@@ -143,8 +148,32 @@ class MultiFeatureListModelBase : public QAbstractItemModel
       return static_cast<QPair< QgsVectorLayer *, QgsFeature >*>( index.internalPointer() );
     }
 
+    //! Returns the row of the feature \a fid of \a layer, -1 if it is not in the model
+    int featureRow( QgsVectorLayer *layer, QgsFeatureId fid ) const;
+    //! Rebuilds the row of each feature after rows moved
+    void indexFeatures();
+    //! Removes the \a rows, contiguous rows are removed as a range and others with a single reset
+    void removeFeatureRows( QList<int> rows );
+    //! Removes the rows of the features deleted while removals were deferred
+    void removeDeferredRows();
+    //! Returns the selected features with their layers, in the order of the rows
+    QList< QPair< QgsVectorLayer *, QgsFeature > > selectedItems() const;
+    //! Returns the layer of the first selected feature
+    QgsVectorLayer *selectionLayer() const;
+    //! Unselects all features, without notifying about the selected count
+    void unselectAll();
+    //! Emits dataChanged for the \a rows, one signal per contiguous range
+    void emitDataChanged( QList<int> rows, const QVector<int> &roles );
+
     QList< QPair< QgsVectorLayer *, QgsFeature > > mFeatures;
-    QList< QPair< QgsVectorLayer *, QgsFeature > > mSelectedFeatures;
+    //! Row of each feature by its layer and id
+    QHash< QPair< QgsVectorLayer *, QgsFeatureId >, int > mFeatureRows;
+    //! Whether the feature of each row is selected
+    QBitArray mSelectedRows;
+    int mSelectedCount = 0;
+    //! Whether deleted features are collected in mDeferredRemovedRows instead of being removed one by one
+    bool mRemovalsDeferred = false;
+    QList<int> mDeferredRemovedRows;
 };
 
 #endif // MULTIFEATURELISTMODELBASE_H
@@ -58,6 +58,7 @@
 
 #include "qgsquickmapsettings.h"
 #include "qgsquickmapcanvasmap.h"
+#include "qgsquickmaprenderstatistics.h"
 #include "qgsquickcoordinatetransformer.h"
 #include "qgsquickmaptransform.h"
 
@@ -66,6 +67,7 @@
 #include "qgismobileapp.h"
 
 #include "appinterface.h"
+#include "featurelisthighlight.h"
 #include "featurelistmodelselection.h"
 #include "featurelistextentcontroller.h"
 #include "modelhelper.h"
@@ -249,6 +251,7 @@ void QgisMobileapp::initDeclarative()
   // Register QgsQuick QML types
   qmlRegisterType<QgsQuickMapCanvasMap>( "org.qgis", 1, 0, "MapCanvasMap" );
   qmlRegisterType<QgsQuickMapSettings>( "org.qgis", 1, 0, "MapSettings" );
+  qmlRegisterUncreatableType<QgsQuickMapRenderStatistics>( "org.qgis", 1, 0, "MapRenderStatistics", "" );
   qmlRegisterType<QgsQuickCoordinateTransformer>( "org.qfield", 1, 0, "CoordinateTransformer" );
 
   REGISTER_SINGLETON( "Utils", QgsQuickUtils, "Utils" );
@@ -283,6 +286,7 @@ void QgisMobileapp::initDeclarative()
   qmlRegisterType<LocatorModelSuperBridge>( "org.qfield", 1, 0, "LocatorModelSuperBridge" );
   qmlRegisterType<LocatorActionsModel>( "org.qfield", 1, 0, "LocatorActionsModel" );
   qmlRegisterType<LinePolygonHighlight>( "org.qfield", 1, 0, "LinePolygonHighlight" );
+  qmlRegisterType<FeatureListHighlight>( "org.qfield", 1, 0, "FeatureListHighlight" );
   qmlRegisterType<QgsGeometryWrapper>( "org.qfield", 1, 0, "QgsGeometryWrapper" );
   qmlRegisterType<ValueMapModel>( "org.qfield", 1, 0, "ValueMapModel" );
   qmlRegisterType<RecentProjectListModel>( "org.qgis", 1, 0, "RecentProjectListModel" );
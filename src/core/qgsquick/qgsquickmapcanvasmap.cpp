@@ -13,10 +13,15 @@
  *                                                                         *
  ***************************************************************************/
 
+#include <QElapsedTimer>
+#include <QPainter>
+#include <QtConcurrent>
 #include <QQuickWindow>
 #include <QScreen>
+#include <QSGRendererInterface>
 #include <QSGSimpleTextureNode>
 
+#include <qgsmaprenderercache.h>
 #include <qgsmaprendererparalleljob.h>
 #include <qgsmessagelog.h>
 #include <qgspallabeling.h>
@@ -27,18 +32,29 @@
 
 #include "qgsquickmapcanvasmap.h"
 #include "qgsquickmapsettings.h"
+#include "qgsquickmaptexture.h"
+#include "qgsquickmaptilestore.h"
 
+#include <cmath>
+
+const double QgsQuickMapCanvasMap::PREVIEW_RESOLUTION_FACTOR = 0.5;
 
 QgsQuickMapCanvasMap::QgsQuickMapCanvasMap( QQuickItem *parent )
   : QQuickItem( parent )
   , mMapSettings( qgis::make_unique<QgsQuickMapSettings>() )
+  , mCache( qgis::make_unique<QgsMapRendererCache>() )
+  , mRenderStatistics( new QgsQuickMapRenderStatistics( this ) )
 {
   connect( this, &QQuickItem::windowChanged, this, &QgsQuickMapCanvasMap::onWindowChanged );
   connect( &mRefreshTimer, &QTimer::timeout, this, &QgsQuickMapCanvasMap::refreshMap );
   connect( &mMapUpdateTimer, &QTimer::timeout, this, &QgsQuickMapCanvasMap::renderJobUpdated );
+  connect( &mPreviewTimer, &QTimer::timeout, this, &QgsQuickMapCanvasMap::renderPreview );
+  connect( &mStoredTilesWatcher, &QFutureWatcherBase::finished, this, &QgsQuickMapCanvasMap::storedTilesLoaded );
+  connect( &mTileStoreFlushTimer, &QTimer::timeout, this, &QgsQuickMapCanvasMap::flushTileStoreInvalidations );
 
   connect( mMapSettings.get(), &QgsQuickMapSettings::extentChanged, this, &QgsQuickMapCanvasMap::onExtentChanged );
   connect( mMapSettings.get(), &QgsQuickMapSettings::layersChanged, this, &QgsQuickMapCanvasMap::onLayersChanged );
+  connect( mMapSettings.get(), &QgsQuickMapSettings::projectChanged, this, &QgsQuickMapCanvasMap::onProjectChanged );
 
   connect( this, &QgsQuickMapCanvasMap::renderStarting, this, &QgsQuickMapCanvasMap::isRenderingChanged );
   connect( this, &QgsQuickMapCanvasMap::mapCanvasRefreshed, this, &QgsQuickMapCanvasMap::isRenderingChanged );
@@ -46,10 +62,41 @@ QgsQuickMapCanvasMap::QgsQuickMapCanvasMap( QQuickItem *parent )
   mMapUpdateTimer.setSingleShot( false );
   mMapUpdateTimer.setInterval( 250 );
   mRefreshTimer.setSingleShot( true );
+  mClock.start();
+  mPreviewTimer.setSingleShot( true );
+  mPreviewTimer.setInterval( 150 );
+  mTileStoreFlushTimer.setSingleShot( true );
+  mTileStoreFlushTimer.setInterval( 1000 );
   setTransformOrigin( QQuickItem::TopLeft );
   setFlags( QQuickItem::ItemHasContents );
 }
 
+QgsQuickMapCanvasMap::~QgsQuickMapCanvasMap()
+{
+  if ( mJob )
+  {
+    // the job may still be writing to the renderer cache, wait for it to finish
+    disconnect( mJob, nullptr, this, nullptr );
+    mJob->cancel();
+    delete mJob;
+  }
+
+  const QList<QgsMapRendererParallelJob *> cancelledJobs = mCancelledJobs.keys();
+  for ( QgsMapRendererParallelJob *job : cancelledJobs )
+  {
+    disconnect( job, nullptr, this, nullptr );
+    job->cancel();
+    delete job;
+  }
+
+  if ( mPreviewJob )
+  {
+    disconnect( mPreviewJob, nullptr, this, nullptr );
+    mPreviewJob->cancel();
+    delete mPreviewJob;
+  }
+}
+
 QgsQuickMapSettings *QgsQuickMapCanvasMap::mapSettings() const
 {
   return mMapSettings.get();
@@ -88,10 +135,8 @@ void QgsQuickMapCanvasMap::pan( QPointF oldPos, QPointF newPos )
   mMapSettings->setExtent( extent );
 }
 
-void QgsQuickMapCanvasMap::refreshMap()
+QgsMapSettings QgsQuickMapCanvasMap::prepareMapSettings() const
 {
-  stopRendering(); // if any...
-
   QgsMapSettings mapSettings = mMapSettings->mapSettings();
 
   //build the expression context
@@ -107,6 +152,137 @@ void QgsQuickMapCanvasMap::refreshMap()
 
   mapSettings.setExpressionContext( expressionContext );
 
+  return mapSettings;
+}
+
+void QgsQuickMapCanvasMap::refreshMap()
+{
+  stopRendering(); // if any...
+
+  // Cancelled jobs keep running until they reach a cancellation point, don't add more load
+  // while too many of them are still around. The refresh is resumed once one of them finished.
+  if ( mCancelledJobs.size() >= MAX_IN_FLIGHT_JOBS )
+  {
+    if ( !mRefreshPending )
+    {
+      mRefreshPending = true;
+      emit isRenderingChanged();
+    }
+    return;
+  }
+  mRefreshPending = false;
+
+  QgsMapSettings mapSettings = prepareMapSettings();
+
+  mJobPrerendered = !mTiledRendering && mPrerenderMargin > 0;
+  if ( mJobPrerendered )
+  {
+    mJobCenter = mapSettings.visibleExtent().center();
+    mapSettings = prerenderMapSettings( mapSettings );
+  }
+
+  if ( mTiledRendering )
+  {
+    mTileMapSettings = mapSettings;
+    mTileContext = QgsQuickMapTileCache::contextKey( mapSettings );
+    mTileRange = QgsQuickMapTileCache::tileRange( mapSettings );
+    mPendingTileRanges = mTileCache.missingTiles( mTileContext, mTileRange );
+
+    if ( mTileStore && !mPendingTileRanges.isEmpty() )
+    {
+      // Missing tiles may have been stored in a previous session, rendering starts once they are read
+      loadStoredTiles();
+      return;
+    }
+
+    startPendingTileJob();
+    return;
+  }
+
+  startJob( mapSettings );
+}
+
+void QgsQuickMapCanvasMap::startPendingTileJob()
+{
+  if ( mPendingTileRanges.isEmpty() )
+  {
+    // all visible tiles are cached, no need to render anything
+    mImageJobId = -1;
+    updateTiledImage();
+    return;
+  }
+
+  mJobTileRange = mPendingTileRanges.takeFirst();
+  startJob( QgsQuickMapTileCache::tileRangeMapSettings( mTileMapSettings, mJobTileRange ) );
+}
+
+QgsMapSettings QgsQuickMapCanvasMap::prerenderMapSettings( const QgsMapSettings &mapSettings ) const
+{
+  const QSize outputSize = mapSettings.outputSize();
+  const int marginWidth = static_cast<int>( std::round( outputSize.width() * mPrerenderMargin ) );
+  const int marginHeight = static_cast<int>( std::round( outputSize.height() * mPrerenderMargin ) );
+  const QSize size( outputSize.width() + 2 * marginWidth, outputSize.height() + 2 * marginHeight );
+  const double mupp = mapSettings.mapUnitsPerPixel();
+
+  QgsPointXY center = mapSettings.visibleExtent().center();
+  if ( mMovementDirection >= 0 )
+  {
+    // The area behind is left soon, move the margin ahead of the movement
+    const double direction = mMovementDirection * M_PI / 180;
+    center.set( center.x() + std::sin( direction ) * marginWidth * mupp,
+                center.y() + std::cos( direction ) * marginHeight * mupp );
+  }
+
+  // Keep the resolution of the visible extent, the margin only adds pixels
+  QgsMapSettings settings = mapSettings;
+  settings.setOutputSize( size );
+  settings.setExtent( QgsRectangle( center.x() - size.width() * mupp / 2, center.y() - size.height() * mupp / 2,
+                                    center.x() + size.width() * mupp / 2, center.y() + size.height() * mupp / 2 ) );
+  return settings;
+}
+
+bool QgsQuickMapCanvasMap::isExtentPrerendered() const
+{
+  if ( !mImagePrerendered || mTiledRendering )
+    return false;
+
+  if ( !coversExtent( mImageMapSettings, mImageCenter ) )
+    return false;
+
+  // The image of a running job replaces the current one once it finishes, it must cover the extent as well
+  if ( mJob && ( !mJobPrerendered || !coversExtent( mJob->mapSettings(), mJobCenter ) ) )
+    return false;
+
+  return true;
+}
+
+bool QgsQuickMapCanvasMap::coversExtent( const QgsMapSettings &imageSettings, const QgsPointXY &imageCenter ) const
+{
+  const QgsMapSettings &mapSettings = mMapSettings->mapSettings();
+  const double mupp = mapSettings.mapUnitsPerPixel();
+  if ( !qgsDoubleNear( mupp, imageSettings.mapUnitsPerPixel(), mupp * 1e-6 )
+       || !qgsDoubleNear( mapSettings.rotation(), imageSettings.rotation() )
+       || mapSettings.destinationCrs() != imageSettings.destinationCrs() )
+    return false;
+
+  // Render the next margin in the background once half of the current one has been panned over
+  const QgsRectangle visibleExtent = mapSettings.visibleExtent();
+  if ( std::fabs( visibleExtent.center().x() - imageCenter.x() ) > visibleExtent.width() * mPrerenderMargin / 2
+       || std::fabs( visibleExtent.center().y() - imageCenter.y() ) > visibleExtent.height() * mPrerenderMargin / 2 )
+    return false;
+
+  const QPolygonF imagePolygon = imageSettings.visiblePolygon();
+  const QPolygonF visiblePolygon = mapSettings.visiblePolygon();
+  for ( const QPointF &point : visiblePolygon )
+  {
+    if ( !imagePolygon.containsPoint( point, Qt::OddEvenFill ) )
+      return false;
+  }
+  return true;
+}
+
+void QgsQuickMapCanvasMap::startJob( const QgsMapSettings &mapSettings )
+{
   // create the renderer job
   Q_ASSERT( !mJob );
   mJob = new QgsMapRendererParallelJob( mapSettings );
@@ -116,17 +292,88 @@ void QgsQuickMapCanvasMap::refreshMap()
 
   connect( mJob, &QgsMapRendererJob::renderingLayersFinished, this, &QgsQuickMapCanvasMap::renderJobUpdated );
   connect( mJob, &QgsMapRendererJob::finished, this, &QgsQuickMapCanvasMap::renderJobFinished );
-  mJob->setCache( mCache );
+  connect( mJob, &QgsMapRendererJob::renderingLayersFinished, mRenderStatistics, &QgsQuickMapRenderStatistics::jobLayersRendered );
 
+  // Tiles are rendered for a different extent by every job, caching layer images would only thrash
+  const bool useCache = !mTiledRendering;
+  if ( useCache )
+  {
+    // Initialize the cache like the job will do, this drops the cached images if the extent or scale changed.
+    // Layers with a valid cached image are not rendered again, the job only composes their images.
+    mCache->init( mapSettings.visibleExtent(), mapSettings.scale() );
+    mJob->setCache( mCache.get() );
+  }
+
+  if ( mTiledRendering )
+  {
+    // Layers invalidated while the job renders make its tiles outdated
+    mJobTileStore = mTileStore;
+    mJobTileCacheGeneration = mTileCache.generation();
+    mJobTileStoreGeneration = mTileStore ? mTileStore->generation() : 0;
+  }
+
+  mJobStatisticsId = mRenderStatistics->jobStarted();
+  mJobStartTime = mClock.elapsed();
   mJob->start();
 
   emit renderStarting();
 }
 
+void QgsQuickMapCanvasMap::updateTiledImage()
+{
+  const QgsMapSettings imageSettings = QgsQuickMapTileCache::tileRangeMapSettings( mTileMapSettings, mTileRange );
+
+  QImage image( imageSettings.outputSize(), QImage::Format_ARGB32_Premultiplied );
+  image.fill( Qt::transparent );
+  mTileCache.drawTiles( mTileContext, mTileRange, image );
+
+  if ( mJob )
+  {
+    // show what has been rendered so far for the missing tiles
+    QPainter painter( &image );
+    painter.drawImage( static_cast<int>( ( mJobTileRange.firstColumn - mTileRange.firstColumn ) * QgsQuickMapTileCache::TILE_SIZE ),
+                       static_cast<int>( ( mJobTileRange.firstRow - mTileRange.firstRow ) * QgsQuickMapTileCache::TILE_SIZE ),
+                       mJob->renderedImage() );
+  }
+
+  mImage = image;
+  mImageMapSettings = imageSettings;
+  mImageScale = 1.0;
+  mImagePrerendered = false;
+  mDirty = true;
+
+  // Temporarily freeze the canvas, we only need to reset the geometry but not trigger a repaint
+  bool freeze = mFreeze;
+  mFreeze = true;
+  updateTransform();
+  mFreeze = freeze;
+
+  update();
+  emit mapCanvasRefreshed();
+}
+
 void QgsQuickMapCanvasMap::renderJobUpdated()
 {
+  // Layers rendered before labeling are shown in any case, but only incremental rendering shows partial images
+  if ( mIncrementalRendering )
+    mRenderStatistics->jobUpdated();
+
+  if ( mTiledRendering )
+  {
+    if ( mJob )
+    {
+      mImageJobId = mJobStatisticsId;
+      updateTiledImage();
+    }
+    return;
+  }
+
   mImage = mJob->renderedImage();
+  mImageJobId = mJobStatisticsId;
   mImageMapSettings = mJob->mapSettings();
+  mImageScale = 1.0;
+  mImagePrerendered = mJobPrerendered;
+  mImageCenter = mJobCenter;
   mDirty = true;
   // Temporarily freeze the canvas, we only need to reset the geometry but not trigger a repaint
   bool freeze = mFreeze;
@@ -151,8 +398,55 @@ void QgsQuickMapCanvasMap::renderJobFinished()
   delete mLabelingResults;
   mLabelingResults = mJob->takeLabelingResults();
 
+  mRenderStatistics->jobFinished( mJob->perLayerRenderingTime() );
+
+  // Exponential moving average of the rendering time, used to adapt the refresh delay
+  const double renderTime = static_cast<double>( mClock.elapsed() - mJobStartTime );
+  mAverageRenderTime = mAverageRenderTime > 0 ? 0.8 * mAverageRenderTime + 0.2 * renderTime : renderTime;
+
+  if ( mTiledRendering )
+  {
+    // A layer was repainted while the tiles were rendered, the refresh it triggered renders them again
+    if ( mTileCache.generation() == mJobTileCacheGeneration )
+    {
+      mTileCache.insertTiles( mTileContext, mJobTileRange, mJob->renderedImage() );
+      if ( mTileStore && mTileStore == mJobTileStore && mTileStore->generation() == mJobTileStoreGeneration )
+      {
+        // Encoding and writing tiles is slow, keep it off the gui thread
+        QtConcurrent::run( [store = mTileStore, context = mTileContext, range = mJobTileRange, image = mJob->renderedImage(), generation = mJobTileStoreGeneration]
+        {
+          store->writeTiles( context, range, image, generation );
+        } );
+      }
+    }
+    mJobTileStore.reset();
+
+    // The tiles of this job are shown, even if the next one starts right away
+    const int jobId = mJobStatisticsId;
+    mJob->deleteLater();
+    mJob = nullptr;
+
+    if ( !mPendingTileRanges.isEmpty() )
+    {
+      mJobTileRange = mPendingTileRanges.takeFirst();
+      startJob( QgsQuickMapTileCache::tileRangeMapSettings( mTileMapSettings, mJobTileRange ) );
+    }
+    else
+    {
+      mMapUpdateTimer.stop();
+    }
+
+    mImageJobId = jobId;
+    updateTiledImage();
+    return;
+  }
+
   mImage = mJob->renderedImage();
+  mImageJobId = mJobStatisticsId;
   mImageMapSettings = mJob->mapSettings();
+  mImageScale = 1.0;
+  mImagePrerendered = mJobPrerendered;
+  mImageCenter = mJobCenter;
 
   // now we are in a slot called from mJob - do not delete it immediately
   // so the class is still valid when the execution returns to the class
@@ -171,6 +465,68 @@ void QgsQuickMapCanvasMap::renderJobFinished()
   emit mapCanvasRefreshed();
 }
 
+void QgsQuickMapCanvasMap::schedulePreview()
+{
+  if ( mPreviewRendering && !mPreviewTimer.isActive() )
+    mPreviewTimer.start();
+}
+
+void QgsQuickMapCanvasMap::renderPreview()
+{
+  // A preview still in progress reschedules itself once finished
+  if ( !mFreeze || mPreviewJob )
+    return;
+
+  QgsMapSettings mapSettings = prepareMapSettings();
+  // Render at a reduced resolution, symbols keep their size on screen as the dpi is reduced accordingly
+  mapSettings.setOutputSize( mapSettings.outputSize() * PREVIEW_RESOLUTION_FACTOR );
+  mapSettings.setOutputDpi( mapSettings.outputDpi() * PREVIEW_RESOLUTION_FACTOR );
+  mapSettings.setFlag( QgsMapSettings::DrawLabeling, false );
+
+  mPreviewJob = new QgsMapRendererParallelJob( mapSettings );
+  connect( mPreviewJob, &QgsMapRendererJob::finished, this, &QgsQuickMapCanvasMap::previewJobFinished );
+  mPreviewJob->start();
+}
+
+void QgsQuickMapCanvasMap::previewJobFinished()
+{
+  QgsMapRendererParallelJob *job = mPreviewJob;
+  mPreviewJob = nullptr;
+
+  // now we are in a slot called from the job - do not delete it immediately
+  job->deleteLater();
+
+  // The gesture is over, the full quality render is on its way
+  if ( !mFreeze )
+    return;
+
+  mImage = job->renderedImage();
+  mImageMapSettings = job->mapSettings();
+  mImageScale = PREVIEW_RESOLUTION_FACTOR;
+  mImageJobId = -1;
+  mImagePrerendered = false;
+  mDirty = true;
+  updateTransform();
+  update();
+
+  // The map kept moving while the preview was rendered
+  if ( mImageMapSettings.visibleExtent() != mMapSettings->visibleExtent() )
+    schedulePreview();
+}
+
+void QgsQuickMapCanvasMap::stopPreviewRendering()
+{
+  mPreviewTimer.stop();
+
+  if ( mPreviewJob )
+  {
+    disconnect( mPreviewJob, &QgsMapRendererJob::finished, this, &QgsQuickMapCanvasMap::previewJobFinished );
+    connect( mPreviewJob, &QgsMapRendererJob::finished, mPreviewJob, &QObject::deleteLater );
+    mPreviewJob->cancelWithoutBlocking();
+    mPreviewJob = nullptr;
+  }
+}
+
 void QgsQuickMapCanvasMap::onWindowChanged( QQuickWindow *window )
 {
   if ( mWindow == window )
@@ -204,15 +560,24 @@ void QgsQuickMapCanvasMap::onExtentChanged()
 {
   updateTransform();
 
+  // The new extent has already been rendered, moving the image is enough
+  if ( isExtentPrerendered() )
+    return;
+
   // And trigger a new rendering job
   refresh();
+
+  // While frozen (e.g. during a gesture) no rendering job is started, show a quick preview instead
+  if ( mFreeze )
+    schedulePreview();
 }
 
 void QgsQuickMapCanvasMap::updateTransform()
 {
   QgsRectangle imageExtent = mImageMapSettings.visibleExtent();
-  QgsRectangle newExtent = mMapSettings->mapSettings().visibleExtent();
-  setScale( imageExtent.width() / newExtent.width() );
+  // the image may cover a larger extent than the canvas (e.g. with tiled rendering) or have a lower
+  // resolution (preview), compare resolutions at full quality
+  setScale( mImageMapSettings.mapUnitsPerPixel() * mImageScale / mMapSettings->mapSettings().mapUnitsPerPixel() );
 
   QgsPointXY pixelPt = mMapSettings->coordinateToScreen( QgsPoint( imageExtent.xMinimum(), imageExtent.yMaximum() ) );
   setX( pixelPt.x() );
@@ -248,6 +613,80 @@ void QgsQuickMapCanvasMap::setIncrementalRendering( bool incrementalRendering )
   emit incrementalRenderingChanged();
 }
 
+bool QgsQuickMapCanvasMap::previewRendering() const
+{
+  return mPreviewRendering;
+}
+
+void QgsQuickMapCanvasMap::setPreviewRendering( bool previewRendering )
+{
+  if ( previewRendering == mPreviewRendering )
+    return;
+
+  mPreviewRendering = previewRendering;
+  if ( !mPreviewRendering )
+    stopPreviewRendering();
+
+  emit previewRenderingChanged();
+}
+
+double QgsQuickMapCanvasMap::prerenderMargin() const
+{
+  return mPrerenderMargin;
+}
+
+void QgsQuickMapCanvasMap::setPrerenderMargin( double prerenderMargin )
+{
+  prerenderMargin = std::max( 0.0, prerenderMargin );
+  if ( qgsDoubleNear( prerenderMargin, mPrerenderMargin ) )
+    return;
+
+  // The margin of the current image is kept until the next extent change
+  mPrerenderMargin = prerenderMargin;
+  emit prerenderMarginChanged();
+}
+
+double QgsQuickMapCanvasMap::movementDirection() const
+{
+  return mMovementDirection;
+}
+
+void QgsQuickMapCanvasMap::setMovementDirection( double movementDirection )
+{
+  if ( qgsDoubleNear( movementDirection, mMovementDirection ) )
+    return;
+
+  // Only used for the next rendering job, the direction changes too often to refresh on every change
+  mMovementDirection = movementDirection;
+  emit movementDirectionChanged();
+}
+
+QgsQuickMapRenderStatistics *QgsQuickMapCanvasMap::renderStatistics() const
+{
+  return mRenderStatistics;
+}
+
+bool QgsQuickMapCanvasMap::tiledRendering() const
+{
+  return mTiledRendering;
+}
+
+void QgsQuickMapCanvasMap::setTiledRendering( bool tiledRendering )
+{
+  if ( tiledRendering == mTiledRendering )
+    return;
+
+  mTiledRendering = tiledRendering;
+  if ( !mTiledRendering )
+    mTileCache.clear();
+  mCache->clear();
+  updateTileStore();
+
+  refresh();
+
+  emit tiledRenderingChanged();
+}
+
 bool QgsQuickMapCanvasMap::freeze() const
 {
   return mFreeze;
@@ -261,41 +700,88 @@ void QgsQuickMapCanvasMap::setFreeze( bool freeze )
   mFreeze = freeze;
 
   if ( !mFreeze )
+  {
+    stopPreviewRendering();
     refresh();
+  }
 
   emit freezeChanged();
 }
 
 bool QgsQuickMapCanvasMap::isRendering() const
 {
-  return mJob;
+  return mJob || mRefreshPending || mLoadingStoredTiles;
 }
 
 QSGNode *QgsQuickMapCanvasMap::updatePaintNode( QSGNode *oldNode, QQuickItem::UpdatePaintNodeData * )
 {
-  if ( mDirty )
+  // With OpenGL the texture is kept and updated in place, other backends get a new texture for every image
+  const bool reuseTexture = window()->rendererInterface()->graphicsApi() == QSGRendererInterface::OpenGL;
+
+  if ( mDirty && !reuseTexture )
   {
     delete oldNode;
     oldNode = nullptr;
-    mDirty = false;
   }
 
   QSGSimpleTextureNode *node = static_cast<QSGSimpleTextureNode *>( oldNode );
+
+  // The time of an upload is reported with the next update, along with the job which rendered the uploaded image
+  double uploadTime = -1;
+  int uploadJobId = mTextureJobId;
+  if ( node && reuseTexture )
+  {
+    uploadTime = static_cast<QgsQuickMapTexture *>( node->texture() )->takeUploadTime();
+  }
+
   if ( !node )
   {
     node = new QSGSimpleTextureNode();
-    QSGTexture *texture = window()->createTextureFromImage( mImage );
-    node->setTexture( texture );
+    if ( reuseTexture )
+    {
+      QgsQuickMapTexture *texture = new QgsQuickMapTexture();
+      texture->setImage( mImage );
+      node->setTexture( texture );
+    }
+    else
+    {
+      QElapsedTimer timer;
+      timer.start();
+      node->setTexture( window()->createTextureFromImage( mImage ) );
+      uploadTime = timer.nsecsElapsed() / 1000000.0;
+      uploadJobId = mImageJobId;
+    }
     node->setOwnsTexture( true );
+    mTextureJobId = mImageJobId;
+  }
+  else if ( mDirty )
+  {
+    // The image is shared with the texture, not copied, and uploaded when the node is rendered
+    static_cast<QgsQuickMapTexture *>( node->texture() )->setImage( mImage );
+    node->markDirty( QSGNode::DirtyMaterial );
+    mTextureJobId = mImageJobId;
+  }
+  mDirty = false;
+
+  if ( uploadTime >= 0 )
+  {
+    // We are on the render thread, the statistics live on the gui thread
+    QgsQuickMapRenderStatistics *statistics = mRenderStatistics;
+    QMetaObject::invokeMethod( statistics, [statistics, uploadTime, uploadJobId] { statistics->setTextureUploadTime( uploadTime, uploadJobId ); }, Qt::QueuedConnection );
   }
 
   QRectF rect( boundingRect() );
   QSizeF size = mImage.size();
   if ( !size.isEmpty() )
-    size /= mMapSettings->devicePixelRatio();
+    size /= mMapSettings->devicePixelRatio() * mImageScale;
 
+  if ( ( mTiledRendering || mImagePrerendered ) && !size.isEmpty() )
+  {
+    // A tiled or pre-rendered image covers a larger extent than the visible extent, draw it at its own size
+    rect = QRectF( QPointF( 0, 0 ), size );
+  }
   // Check for resizes that change the w/h ratio
-  if ( !rect.isEmpty() &&
+  else if ( !rect.isEmpty() &&
        !size.isEmpty() &&
        !qgsDoubleNear( rect.width() / rect.height(), ( size.width() ) / static_cast<double>( size.height() ), 3 ) )
   {
@@ -338,12 +824,130 @@ void QgsQuickMapCanvasMap::onLayersChanged()
   const QList<QgsMapLayer *> layers = mMapSettings->layers();
   for ( QgsMapLayer *layer : layers )
   {
-    mLayerConnections << connect( layer, &QgsMapLayer::repaintRequested, this, &QgsQuickMapCanvasMap::refresh );
+    mLayerConnections << connect( layer, &QgsMapLayer::repaintRequested, this, &QgsQuickMapCanvasMap::onLayerRepaintRequested );
+    mLayerConnections << connect( layer, &QgsMapLayer::styleChanged, this, &QgsQuickMapCanvasMap::onLayerRepaintRequested );
   }
 
+  updateTileStore();
+
   refresh();
 }
 
+void QgsQuickMapCanvasMap::onLayerRepaintRequested()
+{
+  QgsMapLayer *layer = qobject_cast<QgsMapLayer *>( sender() );
+  if ( layer )
+  {
+    // Only this layer needs to be rendered again, all others are composed from the renderer cache
+    mCache->invalidateCacheForLayer( layer );
+    mTileCache.invalidateLayer( layer->id() );
+    if ( mTileStore )
+    {
+      // Stored tiles are only marked as outdated, they are deleted in batches off the gui thread
+      mTileStore->invalidateLayer( layer->id() );
+      if ( !mTileStoreFlushTimer.isActive() )
+        mTileStoreFlushTimer.start();
+    }
+  }
+
+  refresh();
+}
+
+void QgsQuickMapCanvasMap::onProjectChanged()
+{
+  if ( mMapSettings->project() )
+    connect( mMapSettings->project(), &QgsProject::cleared, this, &QgsQuickMapCanvasMap::onProjectCleared, Qt::UniqueConnection );
+}
+
+void QgsQuickMapCanvasMap::onProjectCleared()
+{
+  // Layers of the next project (or of the same project once reloaded) need to be checked against the tile store again
+  mValidatedTileStoreLayers.clear();
+}
+
+void QgsQuickMapCanvasMap::updateTileStore()
+{
+  QgsProject *project = mMapSettings->project();
+  const QString path = mTiledRendering && project ? QgsQuickMapTileStore::storePath( project->fileName() ) : QString();
+
+  if ( path.isEmpty() )
+  {
+    mTileStore.reset();
+    return;
+  }
+
+  if ( !mTileStore || mTileStore->path() != path )
+  {
+    mTileStore = std::make_shared<QgsQuickMapTileStore>( path );
+    mValidatedTileStoreLayers.clear();
+    if ( !mTileStore->isValid() )
+    {
+      mTileStore.reset();
+      return;
+    }
+  }
+
+  // Drop persisted tiles of layers which have been modified since they were rendered
+  QList<QgsMapLayer *> layers;
+  const QList<QgsMapLayer *> projectLayers = project->mapLayers().values();
+  for ( QgsMapLayer *layer : projectLayers )
+  {
+    if ( !mValidatedTileStoreLayers.contains( layer->id() ) )
+    {
+      layers << layer;
+      mValidatedTileStoreLayers.insert( layer->id() );
+    }
+  }
+  mTileStore->validateLayers( layers );
+}
+
+void QgsQuickMapCanvasMap::loadStoredTiles()
+{
+  mLoadingStoredTiles = true;
+  mStoredTilesContext = mTileContext;
+  mStoredTilesCacheGeneration = mTileCache.generation();
+  mStoredTilesStoreGeneration = mTileStore->generation();
+
+  // Reading and decoding tiles is slow, keep it off the gui thread
+  mStoredTilesWatcher.setFuture( QtConcurrent::run( [store = mTileStore, context = mTileContext, ranges = mPendingTileRanges]
+  {
+    return store->readTiles( context, ranges );
+  } ) );
+
+  emit isRenderingChanged();
+}
+
+void QgsQuickMapCanvasMap::storedTilesLoaded()
+{
+  const QgsQuickMapTileStore::TileImages tiles = mStoredTilesWatcher.result();
+
+  // A layer was repainted while the tiles were read, the refresh it triggered reads them again
+  if ( mTileStore && mTileCache.generation() == mStoredTilesCacheGeneration && mTileStore->generation() == mStoredTilesStoreGeneration )
+  {
+    for ( auto it = tiles.constBegin(); it != tiles.constEnd(); ++it )
+      mTileCache.insertTile( mStoredTilesContext, it.key().first, it.key().second, it.value() );
+  }
+
+  // Rendering has been stopped meanwhile
+  if ( !mLoadingStoredTiles )
+    return;
+
+  mLoadingStoredTiles = false;
+  mPendingTileRanges = mTileCache.missingTiles( mTileContext, mTileRange );
+  startPendingTileJob();
+}
+
+void QgsQuickMapCanvasMap::flushTileStoreInvalidations()
+{
+  if ( !mTileStore )
+    return;
+
+  QtConcurrent::run( [store = mTileStore]
+  {
+    store->flushInvalidations();
+  } );
+}
+
 void QgsQuickMapCanvasMap::destroyJob( QgsMapRendererJob *job )
 {
   job->cancel();
@@ -356,10 +960,34 @@ void QgsQuickMapCanvasMap::stopRendering()
   {
     disconnect( mJob, &QgsMapRendererJob::renderingLayersFinished, this, &QgsQuickMapCanvasMap::renderJobUpdated );
     disconnect( mJob, &QgsMapRendererJob::finished, this, &QgsQuickMapCanvasMap::renderJobFinished );
+    disconnect( mJob, nullptr, mRenderStatistics, nullptr );
+
+    // The job only stops at its next cancellation point, keep track of it until it is really finished
+    mCancelledJobs.insert( mJob, mJobStartTime );
+    connect( mJob, &QgsMapRendererJob::finished, this, &QgsQuickMapCanvasMap::cancelledJobFinished );
 
     mJob->cancelWithoutBlocking();
     mJob = nullptr;
   }
+
+  mMapUpdateTimer.stop();
+  mPendingTileRanges.clear();
+  mLoadingStoredTiles = false;
+}
+
+void QgsQuickMapCanvasMap::cancelledJobFinished()
+{
+  QgsMapRendererParallelJob *job = qobject_cast<QgsMapRendererParallelJob *>( sender() );
+  if ( !job || !mCancelledJobs.contains( job ) )
+    return;
+
+  mRenderStatistics->jobCancelled( static_cast<int>( mClock.elapsed() - mCancelledJobs.take( job ) ) );
+
+  // now we are in a slot called from the job - do not delete it immediately
+  job->deleteLater();
+
+  if ( mRefreshPending && !mFreeze )
+    refreshMap();
 }
 
 void QgsQuickMapCanvasMap::zoomToFullExtent()
@@ -388,6 +1016,24 @@ void QgsQuickMapCanvasMap::refresh()
   if ( mMapSettings->outputSize().isNull() )
     return;  // the map image size has not been set yet
 
-  if ( !mFreeze )
-    mRefreshTimer.start( 1 );
+  if ( mFreeze )
+    return;
+
+  if ( !mRefreshTimer.isActive() )
+  {
+    mRefreshRequestTime = mClock.elapsed();
+  }
+  else if ( mClock.elapsed() - mRefreshRequestTime >= MAX_REFRESH_DELAY )
+  {
+    // Refreshes have been postponed for too long already, let the pending one start
+    return;
+  }
+
+  // While jobs are running, refresh requests arrive faster than they can be rendered.
+  // Wait a fraction of the typical rendering time so that requests coalesce into one job.
+  int delay = 1;
+  if ( mJob || !mCancelledJobs.isEmpty() )
+    delay = qBound( 1, static_cast<int>( mAverageRenderTime / 4 ), MAX_REFRESH_DELAY );
+
+  mRefreshTimer.start( delay );
 }
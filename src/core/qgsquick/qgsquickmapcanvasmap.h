@@ -20,15 +20,21 @@
 
 #include <QtQuick/QQuickItem>
 #include <QFutureSynchronizer>
+#include <QFutureWatcher>
+#include <QElapsedTimer>
+#include <QSet>
 #include <QTimer>
 
+#include <qgsmaprenderercache.h>
 #include <qgsmapsettings.h>
 #include <qgspoint.h>
 
+#include "qgsquickmaprenderstatistics.h"
 #include "qgsquickmapsettings.h"
+#include "qgsquickmaptilecache.h"
+#include "qgsquickmaptilestore.h"
 
 class QgsMapRendererParallelJob;
-class QgsMapRendererCache;
 class QgsLabelingResults;
 
 /**
@@ -50,6 +56,8 @@ class QgsQuickMapCanvasMap : public QQuickItem
 {
     Q_OBJECT
 
+    friend class TestQgsQuickMapCanvasMap;
+
     /**
      * The mapSettings property contains configuration for rendering of the map.
      *
@@ -85,10 +93,51 @@ class QgsQuickMapCanvasMap : public QQuickItem
      */
     Q_PROPERTY( bool incrementalRendering READ incrementalRendering WRITE setIncrementalRendering NOTIFY incrementalRenderingChanged )
 
+    /**
+     * When the tiledRendering property is set to true, the map is rendered in fixed-size tiles which are
+     * kept in a memory cache and reused when the map is panned or returns to a previously visited scale.
+     * Only tiles which are not cached yet are rendered.
+     *
+     * Labels are placed per rendered block of tiles and may be clipped at its border.
+     *
+     * Rendered tiles are also persisted next to the project file (see QgsQuickMapTileStore)
+     * and reused when the project is opened again.
+     */
+    Q_PROPERTY( bool tiledRendering READ tiledRendering WRITE setTiledRendering NOTIFY tiledRenderingChanged )
+
+    /**
+     * When the previewRendering property is set to true, a low resolution preview of the map is rendered
+     * at regular intervals while the canvas is frozen (e.g. during a pan or pinch gesture), so newly exposed
+     * areas do not stay blank. The full quality image replaces it once the canvas is unfrozen.
+     */
+    Q_PROPERTY( bool previewRendering READ previewRendering WRITE setPreviewRendering NOTIFY previewRenderingChanged )
+
+    /**
+     * Fraction of the canvas width and height which is additionally rendered on every side of the visible extent.
+     * As long as the visible extent stays within the pre-rendered area and the scale does not change, moving the
+     * map only moves the existing image. A new image is rendered in the background once half of the margin has
+     * been panned over.
+     *
+     * Only used when tiledRendering is disabled. Default is 0 (no margin).
+     */
+    Q_PROPERTY( double prerenderMargin READ prerenderMargin WRITE setPrerenderMargin NOTIFY prerenderMarginChanged )
+
+    /**
+     * Direction of the movement of the map in degrees clockwise from north, e.g. the heading of the
+     * GPS position the map follows. When set, the pre-rendered margin is shifted ahead of the movement.
+     * A negative value means no movement is predicted. Default is -1.
+     */
+    Q_PROPERTY( double movementDirection READ movementDirection WRITE setMovementDirection NOTIFY movementDirectionChanged )
+
+    /**
+     * Timings of the rendering jobs of this map canvas map, e.g. for a debug overlay.
+     */
+    Q_PROPERTY( QgsQuickMapRenderStatistics *renderStatistics READ renderStatistics CONSTANT )
+
   public:
     //! Create map canvas map
     explicit QgsQuickMapCanvasMap( QQuickItem *parent = nullptr );
-    ~QgsQuickMapCanvasMap() = default;
+    ~QgsQuickMapCanvasMap();
 
     QSGNode *updatePaintNode( QSGNode *oldNode, QQuickItem::UpdatePaintNodeData * ) override;
 
@@ -116,6 +165,33 @@ class QgsQuickMapCanvasMap : public QQuickItem
     //! \copydoc QgsQuickMapCanvasMap::incrementalRendering
     void setIncrementalRendering( bool incrementalRendering );
 
+    //! \copydoc QgsQuickMapCanvasMap::previewRendering
+    bool previewRendering() const;
+
+    //! \copydoc QgsQuickMapCanvasMap::previewRendering
+    void setPreviewRendering( bool previewRendering );
+
+    //! \copydoc QgsQuickMapCanvasMap::prerenderMargin
+    double prerenderMargin() const;
+
+    //! \copydoc QgsQuickMapCanvasMap::prerenderMargin
+    void setPrerenderMargin( double prerenderMargin );
+
+    //! \copydoc QgsQuickMapCanvasMap::movementDirection
+    double movementDirection() const;
+
+    //! \copydoc QgsQuickMapCanvasMap::movementDirection
+    void setMovementDirection( double movementDirection );
+
+    //! \copydoc QgsQuickMapCanvasMap::renderStatistics
+    QgsQuickMapRenderStatistics *renderStatistics() const;
+
+    //! \copydoc QgsQuickMapCanvasMap::tiledRendering
+    bool tiledRendering() const;
+
+    //! \copydoc QgsQuickMapCanvasMap::tiledRendering
+    void setTiledRendering( bool tiledRendering );
+
   signals:
 
     /**
@@ -140,6 +216,18 @@ class QgsQuickMapCanvasMap : public QQuickItem
     //!\copydoc QgsQuickMapCanvasMap::incrementalRendering
     void incrementalRenderingChanged();
 
+    //!\copydoc QgsQuickMapCanvasMap::previewRendering
+    void previewRenderingChanged();
+
+    //!\copydoc QgsQuickMapCanvasMap::tiledRendering
+    void tiledRenderingChanged();
+
+    //!\copydoc QgsQuickMapCanvasMap::prerenderMargin
+    void prerenderMarginChanged();
+
+    //!\copydoc QgsQuickMapCanvasMap::movementDirection
+    void movementDirectionChanged();
+
   protected:
     void geometryChanged( const QRectF &newGeometry, const QRectF &oldGeometry ) override;
 
@@ -171,6 +259,14 @@ class QgsQuickMapCanvasMap : public QQuickItem
     void onScreenChanged( QScreen *screen );
     void onExtentChanged();
     void onLayersChanged();
+    void onLayerRepaintRequested();
+    void cancelledJobFinished();
+    void renderPreview();
+    void previewJobFinished();
+    void onProjectChanged();
+    void onProjectCleared();
+    void storedTilesLoaded();
+    void flushTileStoreInvalidations();
 
   private:
 
@@ -179,6 +275,17 @@ class QgsQuickMapCanvasMap : public QQuickItem
      */
     void destroyJob( QgsMapRendererJob *job );
     QgsMapSettings prepareMapSettings() const;
+    QgsMapSettings prerenderMapSettings( const QgsMapSettings &mapSettings ) const;
+    bool isExtentPrerendered() const;
+    //! Returns TRUE if an image rendered for \a imageSettings around \a imageCenter shows the current extent
+    bool coversExtent( const QgsMapSettings &imageSettings, const QgsPointXY &imageCenter ) const;
+    void startJob( const QgsMapSettings &mapSettings );
+    void updateTiledImage();
+    void startPendingTileJob();
+    void schedulePreview();
+    void stopPreviewRendering();
+    void updateTileStore();
+    void loadStoredTiles();
     void updateTransform();
     void zoomToFullExtent();
 
@@ -186,10 +293,34 @@ class QgsQuickMapCanvasMap : public QQuickItem
     bool mPinching = false;
     QPoint mPinchStartPoint;
     QgsMapRendererParallelJob *mJob = nullptr;
-    QgsMapRendererCache *mCache = nullptr;
+    //! Start time of the current job on mClock
+    qint64 mJobStartTime = 0;
+    //! Id of the current job in the render statistics
+    int mJobStatisticsId = -1;
+    //! Jobs which have been cancelled but are not finished yet, with their start time on mClock
+    QHash<QgsMapRendererParallelJob *, qint64> mCancelledJobs;
+    //! Maximum number of running jobs, including cancelled ones
+    static const int MAX_IN_FLIGHT_JOBS = 2;
+    //! Maximum time in milliseconds a refresh may be postponed to coalesce it with following ones
+    static const int MAX_REFRESH_DELAY = 100;
+    //! A refresh was requested while too many jobs were running
+    bool mRefreshPending = false;
+    //! Time of the first refresh request on mClock since the last refresh started
+    qint64 mRefreshRequestTime = 0;
+    //! Moving average of the time needed by finished jobs in milliseconds
+    double mAverageRenderTime = 0;
+    QElapsedTimer mClock;
+    std::unique_ptr<QgsMapRendererCache> mCache;
     QgsLabelingResults *mLabelingResults = nullptr;
+    QgsQuickMapRenderStatistics *mRenderStatistics = nullptr;
     QImage mImage;
     QgsMapSettings mImageMapSettings;
+    //! Resolution of mImage relative to a full quality render
+    double mImageScale = 1.0;
+    //! Statistics id of the job which rendered mImage, -1 for previews and images composed of cached tiles only
+    int mImageJobId = -1;
+    //! Statistics id of the job which rendered the image of the texture, only used on the render thread
+    int mTextureJobId = -1;
     QTimer mRefreshTimer;
     bool mDirty = false;
     bool mFreeze = false;
@@ -197,6 +328,43 @@ class QgsQuickMapCanvasMap : public QQuickItem
     QTimer mMapUpdateTimer;
     bool mIncrementalRendering = false;
 
+    //! Resolution of preview images relative to a full quality render
+    static const double PREVIEW_RESOLUTION_FACTOR;
+    bool mPreviewRendering = false;
+    QTimer mPreviewTimer;
+    QgsMapRendererParallelJob *mPreviewJob = nullptr;
+
+    double mPrerenderMargin = 0.0;
+    double mMovementDirection = -1.0;
+    //! The current job renders a margin around the visible extent centered on mJobCenter
+    bool mJobPrerendered = false;
+    QgsPointXY mJobCenter;
+    //! mImage has been rendered with a margin around the visible extent centered on mImageCenter
+    bool mImagePrerendered = false;
+    QgsPointXY mImageCenter;
+
+    bool mTiledRendering = false;
+    QgsQuickMapTileCache mTileCache;
+    QgsMapSettings mTileMapSettings;
+    QString mTileContext;
+    QgsQuickMapTileCache::TileRange mTileRange;
+    QgsQuickMapTileCache::TileRange mJobTileRange;
+    QList<QgsQuickMapTileCache::TileRange> mPendingTileRanges;
+    std::shared_ptr<QgsQuickMapTileStore> mTileStore;
+    QSet<QString> mValidatedTileStoreLayers;
+    //! Reads the stored tiles of mPendingTileRanges, the tiles still missing afterwards are rendered
+    QFutureWatcher<QgsQuickMapTileStore::TileImages> mStoredTilesWatcher;
+    bool mLoadingStoredTiles = false;
+    QString mStoredTilesContext;
+    int mStoredTilesCacheGeneration = 0;
+    int mStoredTilesStoreGeneration = 0;
+    //! Deletes tiles of repainted layers from the tile store at most once per interval
+    QTimer mTileStoreFlushTimer;
+    //! Tile store and generations of the tile cache and store when the current job started
+    std::shared_ptr<QgsQuickMapTileStore> mJobTileStore;
+    int mJobTileCacheGeneration = 0;
+    int mJobTileStoreGeneration = 0;
+
     QQuickWindow *mWindow = nullptr;
 
     QSizeF mOutputSize;
@@ -0,0 +1,271 @@
+/***************************************************************************
+  qgsquickmaprenderstatistics.cpp
+  --------------------------------------
+  Date                 : 16.10.2026
+  Copyright            : (C) 2026 by QField contributors
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QStandardPaths>
+#include <QTextStream>
+
+#include <qgsmaplayer.h>
+
+#include <algorithm>
+
+#include "qgsquickmaprenderstatistics.h"
+
+
+QgsQuickMapRenderStatistics::QgsQuickMapRenderStatistics( QObject *parent )
+  : QObject( parent )
+{
+}
+
+QVariantList QgsQuickMapRenderStatistics::layerTimes() const
+{
+  QVariantList layerTimes;
+  if ( mHistory.isEmpty() )
+    return layerTimes;
+
+  const QList<LayerTime> times = mHistory.last().layerTimes;
+  for ( const LayerTime &time : times )
+  {
+    QVariantMap entry;
+    entry.insert( QStringLiteral( "layerId" ), time.layerId );
+    entry.insert( QStringLiteral( "name" ), time.name );
+    entry.insert( QStringLiteral( "time" ), time.time );
+    layerTimes << entry;
+  }
+  return layerTimes;
+}
+
+int QgsQuickMapRenderStatistics::totalTime() const
+{
+  return mHistory.isEmpty() ? 0 : mHistory.last().totalTime;
+}
+
+int QgsQuickMapRenderStatistics::labelingTime() const
+{
+  return mHistory.isEmpty() ? 0 : mHistory.last().labelingTime;
+}
+
+int QgsQuickMapRenderStatistics::firstUpdateTime() const
+{
+  return mHistory.isEmpty() ? -1 : mHistory.last().firstUpdateTime;
+}
+
+double QgsQuickMapRenderStatistics::textureUploadTime() const
+{
+  return mTextureUploadTime;
+}
+
+void QgsQuickMapRenderStatistics::setTextureUploadTime( double textureUploadTime, int jobId )
+{
+  mTextureUploadTime = textureUploadTime;
+
+  // The image may be shown before its job finished or after the next job started
+  if ( jobId >= 0 )
+  {
+    if ( jobId == mJobId && mTimer.isValid() )
+    {
+      mJobTextureUploadTime = textureUploadTime;
+    }
+    else
+    {
+      for ( auto it = mHistory.rbegin(); it != mHistory.rend(); ++it )
+      {
+        if ( it->id == jobId )
+        {
+          it->textureUploadTime = textureUploadTime;
+          break;
+        }
+      }
+    }
+  }
+
+  emit textureUploadTimeChanged();
+}
+
+int QgsQuickMapRenderStatistics::jobCount() const
+{
+  return mJobCount;
+}
+
+int QgsQuickMapRenderStatistics::cancelledJobCount() const
+{
+  return mCancelledJobCount;
+}
+
+int QgsQuickMapRenderStatistics::wastedTime() const
+{
+  return mWastedTime;
+}
+
+void QgsQuickMapRenderStatistics::jobCancelled( int time )
+{
+  ++mCancelledJobCount;
+  mWastedTime += time;
+  emit cancelledJobsChanged();
+}
+
+int QgsQuickMapRenderStatistics::jobStarted()
+{
+  mTimer.start();
+  mJobStartTime = QDateTime::currentMSecsSinceEpoch();
+  mLayersRenderedTime = -1;
+  mFirstUpdateTime = -1;
+  mJobTextureUploadTime = 0;
+  return ++mJobId;
+}
+
+void QgsQuickMapRenderStatistics::jobUpdated()
+{
+  if ( mFirstUpdateTime < 0 && mTimer.isValid() )
+    mFirstUpdateTime = static_cast<int>( mTimer.elapsed() );
+}
+
+void QgsQuickMapRenderStatistics::jobLayersRendered()
+{
+  if ( mTimer.isValid() )
+    mLayersRenderedTime = static_cast<int>( mTimer.elapsed() );
+}
+
+void QgsQuickMapRenderStatistics::jobFinished( const QHash<QgsMapLayer *, int> &layerTimes )
+{
+  if ( !mTimer.isValid() )
+    return;
+
+  Job job;
+  job.id = mJobId;
+  job.startTime = mJobStartTime;
+  job.totalTime = static_cast<int>( mTimer.elapsed() );
+  job.labelingTime = mLayersRenderedTime >= 0 ? job.totalTime - mLayersRenderedTime : 0;
+  job.firstUpdateTime = mFirstUpdateTime;
+  job.textureUploadTime = mJobTextureUploadTime;
+
+  for ( auto it = layerTimes.constBegin(); it != layerTimes.constEnd(); ++it )
+  {
+    LayerTime time;
+    if ( it.key() )
+    {
+      time.layerId = it.key()->id();
+      time.name = it.key()->name();
+    }
+    time.time = it.value();
+    job.layerTimes << time;
+  }
+  std::sort( job.layerTimes.begin(), job.layerTimes.end(), []( const LayerTime & a, const LayerTime & b )
+  {
+    return a.time > b.time;
+  } );
+
+  mHistory << job;
+  while ( mHistory.size() > MAXIMUM_HISTORY_SIZE )
+    mHistory.removeFirst();
+
+  mTimer.invalidate();
+  ++mJobCount;
+
+  emit statisticsChanged();
+}
+
+QString QgsQuickMapRenderStatistics::toJson() const
+{
+  QJsonArray jobs;
+  for ( const Job &job : mHistory )
+  {
+    QJsonArray layers;
+    for ( const LayerTime &time : job.layerTimes )
+    {
+      QJsonObject layer;
+      layer.insert( QStringLiteral( "layerId" ), time.layerId );
+      layer.insert( QStringLiteral( "name" ), time.name );
+      layer.insert( QStringLiteral( "time" ), time.time );
+      layers.append( layer );
+    }
+
+    QJsonObject entry;
+    entry.insert( QStringLiteral( "id" ), job.id );
+    entry.insert( QStringLiteral( "start" ), QDateTime::fromMSecsSinceEpoch( job.startTime ).toString( Qt::ISODateWithMs ) );
+    entry.insert( QStringLiteral( "totalTime" ), job.totalTime );
+    entry.insert( QStringLiteral( "labelingTime" ), job.labelingTime );
+    entry.insert( QStringLiteral( "firstUpdateTime" ), job.firstUpdateTime );
+    entry.insert( QStringLiteral( "textureUploadTime" ), job.textureUploadTime );
+    entry.insert( QStringLiteral( "layers" ), layers );
+    jobs.append( entry );
+  }
+
+  return QString::fromUtf8( QJsonDocument( jobs ).toJson( QJsonDocument::Indented ) );
+}
+
+QString QgsQuickMapRenderStatistics::toCsv() const
+{
+  QString csv;
+  QTextStream stream( &csv );
+  stream << "job,start,total_time,labeling_time,first_update_time,texture_upload_time,layer_id,layer_name,layer_time\n";
+
+  for ( const Job &job : mHistory )
+  {
+    const QString jobColumns = QStringLiteral( "%1,%2,%3,%4,%5,%6" ).arg( job.id )
+                               .arg( QDateTime::fromMSecsSinceEpoch( job.startTime ).toString( Qt::ISODateWithMs ) )
+                               .arg( job.totalTime )
+                               .arg( job.labelingTime )
+                               .arg( job.firstUpdateTime )
+                               .arg( job.textureUploadTime, 0, 'f', 3 );
+
+    // Jobs where every layer came from the cache still get a line
+    if ( job.layerTimes.isEmpty() )
+      stream << jobColumns << ",,,\n";
+
+    for ( const LayerTime &time : job.layerTimes )
+    {
+      QString name = time.name;
+      name.replace( '"', QStringLiteral( "\"\"" ) );
+      stream << jobColumns << ',' << time.layerId << ",\"" << name << "\"," << time.time << '\n';
+    }
+  }
+
+  return csv;
+}
+
+QString QgsQuickMapRenderStatistics::dump( const QString &directory ) const
+{
+  const QString path = directory.isEmpty() ? QStandardPaths::writableLocation( QStandardPaths::AppDataLocation ) : directory;
+  if ( !QDir().mkpath( path ) )
+    return QString();
+
+  const QDir dir( path );
+  QFile jsonFile( dir.filePath( QStringLiteral( "render_statistics.json" ) ) );
+  QFile csvFile( dir.filePath( QStringLiteral( "render_statistics.csv" ) ) );
+  if ( !jsonFile.open( QIODevice::WriteOnly | QIODevice::Truncate ) || !csvFile.open( QIODevice::WriteOnly | QIODevice::Truncate ) )
+    return QString();
+
+  jsonFile.write( toJson().toUtf8() );
+  csvFile.write( toCsv().toUtf8() );
+
+  return path;
+}
+
+void QgsQuickMapRenderStatistics::clear()
+{
+  mHistory.clear();
+  mJobCount = 0;
+  mCancelledJobCount = 0;
+  mWastedTime = 0;
+  mTextureUploadTime = 0;
+  emit statisticsChanged();
+  emit textureUploadTimeChanged();
+  emit cancelledJobsChanged();
+}
@@ -0,0 +1,183 @@
+/***************************************************************************
+  qgsquickmaprenderstatistics.h
+  --------------------------------------
+  Date                 : 16.10.2026
+  Copyright            : (C) 2026 by QField contributors
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef QGSQUICKMAPRENDERSTATISTICS_H
+#define QGSQUICKMAPRENDERSTATISTICS_H
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QVariantList>
+
+class QgsMapLayer;
+
+/**
+ * The QgsQuickMapRenderStatistics class collects timings of the rendering jobs of a map canvas.
+ *
+ * The properties describe the last finished rendering job. A bounded history of jobs
+ * is kept for the CSV and JSON exports.
+ *
+ * \sa QgsQuickMapCanvasMap::renderStatistics
+ */
+class QgsQuickMapRenderStatistics : public QObject
+{
+    Q_OBJECT
+
+    /**
+     * Rendering time per layer of the last job, sorted from slowest to fastest.
+     * Every entry is a map with the keys "layerId", "name" and "time" (milliseconds).
+     */
+    Q_PROPERTY( QVariantList layerTimes READ layerTimes NOTIFY statisticsChanged )
+
+    //! Total time of the last job in milliseconds
+    Q_PROPERTY( int totalTime READ totalTime NOTIFY statisticsChanged )
+
+    //! Time spent on labeling after all layers were rendered in the last job, in milliseconds
+    Q_PROPERTY( int labelingTime READ labelingTime NOTIFY statisticsChanged )
+
+    /**
+     * Time from the start of the last job until its first incremental update was shown, in milliseconds.
+     * -1 if the job finished before any incremental update or incremental rendering is disabled.
+     */
+    Q_PROPERTY( int firstUpdateTime READ firstUpdateTime NOTIFY statisticsChanged )
+
+    /**
+     * Time spent uploading the last map image into a texture, in milliseconds.
+     * The exports account every upload to the job which rendered the image.
+     */
+    Q_PROPERTY( double textureUploadTime READ textureUploadTime NOTIFY textureUploadTimeChanged )
+
+    //! Number of jobs finished since the statistics were created or cleared
+    Q_PROPERTY( int jobCount READ jobCount NOTIFY statisticsChanged )
+
+    //! Number of jobs cancelled since the statistics were created or cleared
+    Q_PROPERTY( int cancelledJobCount READ cancelledJobCount NOTIFY cancelledJobsChanged )
+
+    /**
+     * Time in milliseconds spent by cancelled jobs, from their start until they actually stopped,
+     * since the statistics were created or cleared.
+     */
+    Q_PROPERTY( int wastedTime READ wastedTime NOTIFY cancelledJobsChanged )
+
+  public:
+    //! Maximum number of jobs kept for exports
+    static const int MAXIMUM_HISTORY_SIZE = 200;
+
+    explicit QgsQuickMapRenderStatistics( QObject *parent = nullptr );
+
+    //! \copydoc QgsQuickMapRenderStatistics::layerTimes
+    QVariantList layerTimes() const;
+
+    //! \copydoc QgsQuickMapRenderStatistics::totalTime
+    int totalTime() const;
+
+    //! \copydoc QgsQuickMapRenderStatistics::labelingTime
+    int labelingTime() const;
+
+    //! \copydoc QgsQuickMapRenderStatistics::firstUpdateTime
+    int firstUpdateTime() const;
+
+    //! \copydoc QgsQuickMapRenderStatistics::textureUploadTime
+    double textureUploadTime() const;
+
+    /**
+     * Sets the time spent uploading the last map image into a texture to \a textureUploadTime,
+     * for the image of the job with \a jobId, or -1 if the image was not rendered by a job.
+     */
+    void setTextureUploadTime( double textureUploadTime, int jobId = -1 );
+
+    //! \copydoc QgsQuickMapRenderStatistics::jobCount
+    int jobCount() const;
+
+    //! \copydoc QgsQuickMapRenderStatistics::cancelledJobCount
+    int cancelledJobCount() const;
+
+    //! \copydoc QgsQuickMapRenderStatistics::wastedTime
+    int wastedTime() const;
+
+    //! To be called when a rendering job starts, returns the id of the job
+    int jobStarted();
+
+    //! To be called when an incremental update of the running job is shown
+    void jobUpdated();
+
+    //! To be called when all layers of the running job are rendered and labeling starts
+    void jobLayersRendered();
+
+    //! To be called when the running job finished with the rendering times of its layers in milliseconds
+    void jobFinished( const QHash<QgsMapLayer *, int> &layerTimes );
+
+    //! To be called when a cancelled job stopped after running for \a time milliseconds
+    void jobCancelled( int time );
+
+    //! Returns the recorded jobs as JSON document
+    Q_INVOKABLE QString toJson() const;
+
+    //! Returns the recorded jobs as CSV with one line per rendered layer and job
+    Q_INVOKABLE QString toCsv() const;
+
+    /**
+     * Writes the recorded jobs as render_statistics.json and render_statistics.csv into \a directory,
+     * or into the application data directory if \a directory is empty.
+     * Returns the directory the files were written to or an empty string on failure.
+     */
+    Q_INVOKABLE QString dump( const QString &directory = QString() ) const;
+
+    //! Removes all recorded jobs
+    Q_INVOKABLE void clear();
+
+  signals:
+    //! Emitted when a job finished or the statistics were cleared
+    void statisticsChanged();
+
+    //! \copydoc QgsQuickMapRenderStatistics::textureUploadTime
+    void textureUploadTimeChanged();
+
+    //! Emitted when a cancelled job stopped or the statistics were cleared
+    void cancelledJobsChanged();
+
+  private:
+    struct LayerTime
+    {
+      QString layerId;
+      QString name;
+      int time = 0;
+    };
+
+    struct Job
+    {
+      int id = -1;
+      qint64 startTime = 0;
+      int totalTime = 0;
+      int labelingTime = 0;
+      int firstUpdateTime = -1;
+      double textureUploadTime = 0;
+      QList<LayerTime> layerTimes;
+    };
+
+    QElapsedTimer mTimer;
+    int mLayersRenderedTime = -1;
+    int mFirstUpdateTime = -1;
+    qint64 mJobStartTime = 0;
+    int mJobId = -1;
+    double mJobTextureUploadTime = 0;
+    double mTextureUploadTime = 0;
+    int mJobCount = 0;
+    int mCancelledJobCount = 0;
+    int mWastedTime = 0;
+    QList<Job> mHistory;
+};
+
+#endif // QGSQUICKMAPRENDERSTATISTICS_H
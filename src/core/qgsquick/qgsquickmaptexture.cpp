@@ -0,0 +1,143 @@
+/***************************************************************************
+  qgsquickmaptexture.cpp
+  --------------------------------------
+  Date                 : 16.10.2026
+  Copyright            : (C) 2026 by QField contributors
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include <QElapsedTimer>
+#include <QOpenGLContext>
+#include <QOpenGLFunctions>
+
+#include "qgsquickmaptexture.h"
+
+#ifndef GL_BGRA
+#define GL_BGRA 0x80E1
+#endif
+
+
+QgsQuickMapTexture::~QgsQuickMapTexture()
+{
+  if ( mTextureId && QOpenGLContext::currentContext() )
+    QOpenGLContext::currentContext()->functions()->glDeleteTextures( 1, &mTextureId );
+}
+
+void QgsQuickMapTexture::setImage( const QImage &image )
+{
+  mImage = image;
+  mDirty = true;
+}
+
+QImage QgsQuickMapTexture::image() const
+{
+  return mImage;
+}
+
+int QgsQuickMapTexture::textureId() const
+{
+  if ( mDirty && !mImage.isNull() && mTextureId == 0 && QOpenGLContext::currentContext() )
+  {
+    // The storage is allocated in a later bind()
+    QgsQuickMapTexture *texture = const_cast<QgsQuickMapTexture *>( this );
+    QOpenGLContext::currentContext()->functions()->glGenTextures( 1, &texture->mTextureId );
+  }
+
+  return static_cast<int>( mTextureId );
+}
+
+QSize QgsQuickMapTexture::textureSize() const
+{
+  return mImage.size();
+}
+
+bool QgsQuickMapTexture::hasAlphaChannel() const
+{
+  return mImage.hasAlphaChannel();
+}
+
+bool QgsQuickMapTexture::hasMipmaps() const
+{
+  return false;
+}
+
+void QgsQuickMapTexture::bind()
+{
+  QOpenGLFunctions *funcs = QOpenGLContext::currentContext()->functions();
+
+  if ( mDirty )
+  {
+    QElapsedTimer timer;
+    timer.start();
+    upload();
+    mUploadTime = timer.nsecsElapsed() / 1000000.0;
+    mDirty = false;
+    updateBindOptions( true );
+    return;
+  }
+
+  funcs->glBindTexture( GL_TEXTURE_2D, mTextureId );
+  updateBindOptions();
+}
+
+double QgsQuickMapTexture::takeUploadTime()
+{
+  const double uploadTime = mUploadTime;
+  mUploadTime = -1;
+  return uploadTime;
+}
+
+void QgsQuickMapTexture::upload()
+{
+  QOpenGLContext *context = QOpenGLContext::currentContext();
+  QOpenGLFunctions *funcs = context->functions();
+
+  if ( mImage.isNull() )
+  {
+    funcs->glBindTexture( GL_TEXTURE_2D, 0 );
+    return;
+  }
+
+  if ( mTextureId == 0 )
+    funcs->glGenTextures( 1, &mTextureId );
+  funcs->glBindTexture( GL_TEXTURE_2D, mTextureId );
+
+  // Desktop GL always accepts BGRA client data, GLES only with an extension which also requires a BGRA internal format
+  const bool bgraSupported = Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+                             && ( !context->isOpenGLES() || context->hasExtension( QByteArrayLiteral( "GL_EXT_texture_format_BGRA8888" ) ) );
+
+  QImage image = mImage;
+  GLenum internalFormat = GL_RGBA;
+  GLenum format = GL_RGBA;
+  if ( bgraSupported )
+  {
+    if ( image.format() != QImage::Format_ARGB32_Premultiplied && image.format() != QImage::Format_RGB32 )
+      image = image.convertToFormat( QImage::Format_ARGB32_Premultiplied );
+    format = GL_BGRA;
+    internalFormat = context->isOpenGLES() ? GL_BGRA : GL_RGBA;
+  }
+  else if ( image.format() != QImage::Format_RGBA8888_Premultiplied && image.format() != QImage::Format_RGBX8888 )
+  {
+    image = image.convertToFormat( QImage::Format_RGBA8888_Premultiplied );
+  }
+
+  funcs->glPixelStorei( GL_UNPACK_ALIGNMENT, 4 );
+
+  if ( image.size() == mTextureSize && bgraSupported == mTextureBgra )
+  {
+    // Same storage, only replace the pixels
+    funcs->glTexSubImage2D( GL_TEXTURE_2D, 0, 0, 0, image.width(), image.height(), format, GL_UNSIGNED_BYTE, image.constBits() );
+  }
+  else
+  {
+    funcs->glTexImage2D( GL_TEXTURE_2D, 0, static_cast<GLint>( internalFormat ), image.width(), image.height(), 0, format, GL_UNSIGNED_BYTE, image.constBits() );
+    mTextureSize = image.size();
+    mTextureBgra = bgraSupported;
+  }
+}
@@ -0,0 +1,72 @@
+/***************************************************************************
+  qgsquickmaptexture.h
+  --------------------------------------
+  Date                 : 16.10.2026
+  Copyright            : (C) 2026 by QField contributors
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef QGSQUICKMAPTEXTURE_H
+#define QGSQUICKMAPTEXTURE_H
+
+#include <QImage>
+#include <QSGTexture>
+
+/**
+ * The QgsQuickMapTexture class is an OpenGL scene graph texture for rendered map images
+ * which is updated in place.
+ *
+ * Unlike textures created with QQuickWindow::createTextureFromImage, the GL texture object is kept
+ * for the whole lifetime of the instance. A new image with the same size is uploaded into the
+ * existing storage, the storage is only reallocated when the size changes. Images are shared,
+ * not copied, and uploaded lazily on the next bind() from the render thread.
+ *
+ * ARGB32 images are uploaded in their native BGRA layout whenever the GL implementation supports it,
+ * which avoids a per frame conversion of the whole image.
+ */
+class QgsQuickMapTexture : public QSGTexture
+{
+    Q_OBJECT
+
+  public:
+    QgsQuickMapTexture() = default;
+    ~QgsQuickMapTexture() override;
+
+    /**
+     * Sets the \a image to show. The image is shared and uploaded on the next bind().
+     */
+    void setImage( const QImage &image );
+
+    //! Returns the image which is currently shown
+    QImage image() const;
+
+    int textureId() const override;
+    QSize textureSize() const override;
+    bool hasAlphaChannel() const override;
+    bool hasMipmaps() const override;
+    void bind() override;
+
+    /**
+     * Returns the time spent on the last upload in milliseconds, or -1 if
+     * the texture has not been uploaded since the last call.
+     */
+    double takeUploadTime();
+
+  private:
+    void upload();
+
+    QImage mImage;
+    bool mDirty = false;
+    unsigned int mTextureId = 0;
+    QSize mTextureSize;
+    bool mTextureBgra = false;
+    double mUploadTime = -1;
+};
+
+#endif // QGSQUICKMAPTEXTURE_H
@@ -0,0 +1,211 @@
+/***************************************************************************
+  qgsquickmaptilecache.cpp
+  --------------------------------------
+  Date                 : 16.10.2026
+  Copyright            : (C) 2026 by QField contributors
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include <QPainter>
+
+#include <qgsmaplayer.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include "qgsquickmaptilecache.h"
+
+
+QgsQuickMapTileCache::QgsQuickMapTileCache( int maxCostKb )
+{
+  mTiles.setMaxCost( maxCostKb );
+}
+
+QString QgsQuickMapTileCache::contextKey( const QgsMapSettings &settings )
+{
+  QStringList layerIds;
+  const QList<QgsMapLayer *> layers = settings.layers();
+  for ( const QgsMapLayer *layer : layers )
+    layerIds << layer->id();
+
+  const QgsCoordinateReferenceSystem crs = settings.destinationCrs();
+
+  return QStringLiteral( "%1|%2|%3|%4|%5" ).arg( QString::number( tileResolution( settings ), 'g', 17 ),
+         crs.authid().isEmpty() ? crs.toWkt() : crs.authid(),
+         QString::number( settings.outputDpi(), 'g', 6 ),
+         settings.backgroundColor().name( QColor::HexArgb ),
+         layerIds.join( QStringLiteral( ";" ) ) );
+}
+
+QStringList QgsQuickMapTileCache::contextLayerIds( const QString &context )
+{
+  return context.section( QChar( '|' ), -1 ).split( QChar( ';' ), QString::SkipEmptyParts );
+}
+
+double QgsQuickMapTileCache::tileResolution( const QgsMapSettings &settings )
+{
+  const double mupp = settings.mapUnitsPerPixel();
+  if ( mupp <= 0 || !std::isfinite( mupp ) )
+    return mupp;
+
+  // Round to 10 significant digits
+  const double magnitude = std::pow( 10.0, std::floor( std::log10( mupp ) ) - 9 );
+  return std::round( mupp / magnitude ) * magnitude;
+}
+
+QgsQuickMapTileCache::TileRange QgsQuickMapTileCache::tileRange( const QgsMapSettings &settings )
+{
+  const double tileExtent = TILE_SIZE * tileResolution( settings );
+  const QgsRectangle extent = settings.visibleExtent();
+
+  if ( tileExtent <= 0 || extent.isEmpty() )
+    return TileRange();
+
+  // Rows grow downwards, like pixel rows do
+  return TileRange( static_cast<qint64>( std::floor( extent.xMinimum() / tileExtent ) ),
+                    static_cast<qint64>( std::ceil( extent.xMaximum() / tileExtent ) ) - 1,
+                    static_cast<qint64>( std::floor( -extent.yMaximum() / tileExtent ) ),
+                    static_cast<qint64>( std::ceil( -extent.yMinimum() / tileExtent ) ) - 1 );
+}
+
+QgsRectangle QgsQuickMapTileCache::tileRangeExtent( const QgsMapSettings &settings, const TileRange &range )
+{
+  const double tileExtent = TILE_SIZE * tileResolution( settings );
+
+  return QgsRectangle( range.firstColumn * tileExtent,
+                       -( range.lastRow + 1 ) * tileExtent,
+                       ( range.lastColumn + 1 ) * tileExtent,
+                       -range.firstRow * tileExtent );
+}
+
+QgsMapSettings QgsQuickMapTileCache::tileRangeMapSettings( const QgsMapSettings &settings, const TileRange &range )
+{
+  QgsMapSettings tileSettings( settings );
+  tileSettings.setOutputSize( QSize( static_cast<int>( range.columnCount() * TILE_SIZE ),
+                                     static_cast<int>( range.rowCount() * TILE_SIZE ) ) );
+  tileSettings.setExtent( tileRangeExtent( settings, range ) );
+  return tileSettings;
+}
+
+bool QgsQuickMapTileCache::hasTile( const QString &context, qint64 column, qint64 row ) const
+{
+  return mTiles.contains( TileKey { context, column, row } );
+}
+
+QList<QgsQuickMapTileCache::TileRange> QgsQuickMapTileCache::missingTiles( const QString &context, const TileRange &range ) const
+{
+  QList<TileRange> missing;
+  // Ranges which ended on the previous row and may still be extended downwards
+  QList<int> openRanges;
+
+  for ( qint64 row = range.firstRow; row <= range.lastRow; ++row )
+  {
+    QList<int> nextOpenRanges;
+    qint64 column = range.firstColumn;
+    while ( column <= range.lastColumn )
+    {
+      if ( hasTile( context, column, row ) )
+      {
+        ++column;
+        continue;
+      }
+
+      const qint64 firstColumn = column;
+      while ( column <= range.lastColumn && !hasTile( context, column, row ) )
+        ++column;
+      const qint64 lastColumn = column - 1;
+
+      auto openIt = std::find_if( openRanges.constBegin(), openRanges.constEnd(), [&missing, firstColumn, lastColumn]( int idx )
+      {
+        return missing.at( idx ).firstColumn == firstColumn && missing.at( idx ).lastColumn == lastColumn;
+      } );
+
+      if ( openIt != openRanges.constEnd() )
+      {
+        missing[*openIt].lastRow = row;
+        nextOpenRanges << *openIt;
+      }
+      else
+      {
+        missing << TileRange( firstColumn, lastColumn, row, row );
+        nextOpenRanges << missing.size() - 1;
+      }
+    }
+    openRanges = nextOpenRanges;
+  }
+
+  return missing;
+}
+
+void QgsQuickMapTileCache::insertTiles( const QString &context, const TileRange &range, const QImage &image )
+{
+  if ( image.width() < range.columnCount() * TILE_SIZE || image.height() < range.rowCount() * TILE_SIZE )
+    return;
+
+  for ( qint64 row = range.firstRow; row <= range.lastRow; ++row )
+  {
+    for ( qint64 column = range.firstColumn; column <= range.lastColumn; ++column )
+    {
+      insertTile( context, column, row, image.copy( static_cast<int>( ( column - range.firstColumn ) * TILE_SIZE ),
+                  static_cast<int>( ( row - range.firstRow ) * TILE_SIZE ),
+                  TILE_SIZE, TILE_SIZE ) );
+    }
+  }
+}
+
+void QgsQuickMapTileCache::insertTile( const QString &context, qint64 column, qint64 row, const QImage &image )
+{
+  QImage *tile = new QImage( image );
+  const int cost = std::max( 1, static_cast<int>( tile->sizeInBytes() / 1024 ) );
+  mTiles.insert( TileKey { context, column, row }, tile, cost );
+}
+
+void QgsQuickMapTileCache::drawTiles( const QString &context, const TileRange &range, QImage &image )
+{
+  QPainter painter( &image );
+  painter.setCompositionMode( QPainter::CompositionMode_Source );
+
+  for ( qint64 row = range.firstRow; row <= range.lastRow; ++row )
+  {
+    for ( qint64 column = range.firstColumn; column <= range.lastColumn; ++column )
+    {
+      // QCache::object() also marks the tile as recently used
+      const QImage *tile = mTiles.object( TileKey { context, column, row } );
+      if ( !tile )
+        continue;
+
+      painter.drawImage( static_cast<int>( ( column - range.firstColumn ) * TILE_SIZE ),
+                         static_cast<int>( ( row - range.firstRow ) * TILE_SIZE ),
+                         *tile );
+    }
+  }
+}
+
+void QgsQuickMapTileCache::invalidateLayer( const QString &layerId )
+{
+  mGeneration++;
+
+  const QList<TileKey> keys = mTiles.keys();
+  for ( const TileKey &key : keys )
+  {
+    if ( contextLayerIds( key.context ).contains( layerId ) )
+      mTiles.remove( key );
+  }
+}
+
+void QgsQuickMapTileCache::clear()
+{
+  mGeneration++;
+  mTiles.clear();
+}
+
+int QgsQuickMapTileCache::generation() const
+{
+  return mGeneration;
+}
@@ -0,0 +1,162 @@
+/***************************************************************************
+  qgsquickmaptilecache.h
+  --------------------------------------
+  Date                 : 16.10.2026
+  Copyright            : (C) 2026 by QField contributors
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef QGSQUICKMAPTILECACHE_H
+#define QGSQUICKMAPTILECACHE_H
+
+#include <QCache>
+#include <QImage>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+#include <qgsmapsettings.h>
+#include <qgsrectangle.h>
+
+/**
+ * The QgsQuickMapTileCache class keeps rendered map tiles in a bounded
+ * least recently used memory cache.
+ *
+ * Tiles have a fixed size in device pixels and are laid out on a grid which is
+ * anchored at the origin of the destination CRS. A tile rendered for one extent
+ * can therefore be reused for any other extent which shares the same scale level,
+ * CRS and layer set. These properties are combined into a context key.
+ *
+ * \sa QgsQuickMapCanvasMap::tiledRendering
+ */
+class QgsQuickMapTileCache
+{
+  public:
+    //! Size of a tile side in device pixels
+    static const int TILE_SIZE = 256;
+
+    //! An inclusive range of tile columns and rows
+    struct TileRange
+    {
+      TileRange() = default;
+      TileRange( qint64 firstColumn, qint64 lastColumn, qint64 firstRow, qint64 lastRow )
+        : firstColumn( firstColumn )
+        , lastColumn( lastColumn )
+        , firstRow( firstRow )
+        , lastRow( lastRow )
+      {}
+
+      bool isValid() const { return lastColumn >= firstColumn && lastRow >= firstRow; }
+      qint64 columnCount() const { return lastColumn - firstColumn + 1; }
+      qint64 rowCount() const { return lastRow - firstRow + 1; }
+
+      bool operator==( const TileRange &other ) const
+      {
+        return firstColumn == other.firstColumn && lastColumn == other.lastColumn
+               && firstRow == other.firstRow && lastRow == other.lastRow;
+      }
+
+      qint64 firstColumn = 0;
+      qint64 lastColumn = -1;
+      qint64 firstRow = 0;
+      qint64 lastRow = -1;
+    };
+
+    /**
+     * Creates a new tile cache which holds up to \a maxCostKb kilobytes of tile images.
+     */
+    explicit QgsQuickMapTileCache( int maxCostKb = 64 * 1024 );
+
+    /**
+     * Returns the key identifying all tiles which can be shared between map \a settings.
+     * It is made of the scale level, the destination CRS, the output DPI and the layer set.
+     */
+    static QString contextKey( const QgsMapSettings &settings );
+
+    //! Returns the ids of the layers which are part of a \a context key
+    static QStringList contextLayerIds( const QString &context );
+
+    /**
+     * Returns the map units per pixel of the tile grid for \a settings.
+     * The value is rounded so that small floating point differences after zooming back and forth
+     * map to the same scale level.
+     */
+    static double tileResolution( const QgsMapSettings &settings );
+
+    //! Returns the range of tiles covering the visible extent of map \a settings
+    static TileRange tileRange( const QgsMapSettings &settings );
+
+    //! Returns the map extent covered by a \a range of tiles for map \a settings
+    static QgsRectangle tileRangeExtent( const QgsMapSettings &settings, const TileRange &range );
+
+    /**
+     * Returns a copy of map \a settings with the extent and output size adjusted to cover
+     * exactly the tiles in \a range.
+     */
+    static QgsMapSettings tileRangeMapSettings( const QgsMapSettings &settings, const TileRange &range );
+
+    //! Returns TRUE if the tile at \a column and \a row is cached for \a context
+    bool hasTile( const QString &context, qint64 column, qint64 row ) const;
+
+    /**
+     * Returns the list of rectangular tile ranges within \a range which are not cached for \a context.
+     * Horizontal runs of missing tiles are merged with the runs of following rows spanning the same columns.
+     */
+    QList<TileRange> missingTiles( const QString &context, const TileRange &range ) const;
+
+    /**
+     * Splits an \a image rendered for the tiles in \a range into single tiles and stores them for \a context.
+     */
+    void insertTiles( const QString &context, const TileRange &range, const QImage &image );
+
+    //! Stores a single tile \a image at \a column and \a row for \a context
+    void insertTile( const QString &context, qint64 column, qint64 row, const QImage &image );
+
+    /**
+     * Draws all tiles in \a range which are cached for \a context on \a image.
+     * The top left tile of \a range is drawn at the top left corner of the image.
+     */
+    void drawTiles( const QString &context, const TileRange &range, QImage &image );
+
+    //! Removes all tiles of contexts including the layer with \a layerId
+    void invalidateLayer( const QString &layerId );
+
+    //! Removes all tiles from the cache
+    void clear();
+
+    /**
+     * Returns the current generation, incremented whenever tiles are invalidated or cleared.
+     * Tiles rendered while the generation changed must not be inserted.
+     */
+    int generation() const;
+
+    //! Identifies a single tile within a context
+    struct TileKey
+    {
+      QString context;
+      qint64 column;
+      qint64 row;
+
+      bool operator==( const TileKey &other ) const
+      {
+        return column == other.column && row == other.row && context == other.context;
+      }
+    };
+
+  private:
+    QCache<TileKey, QImage> mTiles;
+    int mGeneration = 0;
+};
+
+inline uint qHash( const QgsQuickMapTileCache::TileKey &key, uint seed = 0 )
+{
+  return qHash( key.context, seed ) ^ qHash( key.column, seed ) ^ ( qHash( key.row, seed ) << 1 );
+}
+
+#endif // QGSQUICKMAPTILECACHE_H
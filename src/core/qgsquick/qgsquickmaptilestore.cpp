@@ -0,0 +1,368 @@
+/***************************************************************************
+  qgsquickmaptilestore.cpp
+  --------------------------------------
+  Date                 : 16.10.2026
+  Copyright            : (C) 2026 by QField contributors
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include <QBuffer>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+
+#include <qgsmaplayer.h>
+#include <qgsmaplayerstyle.h>
+#include <qgsmessagelog.h>
+#include <qgsproviderregistry.h>
+
+#include <sqlite3.h>
+
+#include "qgsquickmaptilestore.h"
+
+
+QgsQuickMapTileStore::QgsQuickMapTileStore( const QString &path )
+  : mPath( path )
+{
+  int status = mDatabase.open_v2( path, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_FULLMUTEX, nullptr );
+  if ( status != SQLITE_OK )
+  {
+    QgsMessageLog::logMessage( QObject::tr( "Could not open tile store %1: %2" ).arg( path, mDatabase.errorMessage() ), QObject::tr( "Rendering" ) );
+    return;
+  }
+
+  QString error;
+  status = mDatabase.exec( QStringLiteral( "PRAGMA journal_mode=WAL;"
+                           "CREATE TABLE IF NOT EXISTS contexts ( id INTEGER PRIMARY KEY, context TEXT UNIQUE NOT NULL );"
+                           "CREATE TABLE IF NOT EXISTS context_layers ( context_id INTEGER NOT NULL, layer_id TEXT NOT NULL );"
+                           "CREATE INDEX IF NOT EXISTS context_layers_layer_id ON context_layers ( layer_id );"
+                           "CREATE TABLE IF NOT EXISTS tiles ( context_id INTEGER NOT NULL, tile_column INTEGER NOT NULL, tile_row INTEGER NOT NULL, tile_data BLOB NOT NULL,"
+                           " PRIMARY KEY ( context_id, tile_column, tile_row ) );"
+                           "CREATE TABLE IF NOT EXISTS layers ( layer_id TEXT PRIMARY KEY, stamp TEXT NOT NULL );" ), error );
+  if ( status != SQLITE_OK )
+  {
+    QgsMessageLog::logMessage( QObject::tr( "Could not initialize tile store %1: %2" ).arg( path, error ), QObject::tr( "Rendering" ) );
+    return;
+  }
+
+  mValid = true;
+}
+
+QgsQuickMapTileStore::~QgsQuickMapTileStore()
+{
+  flushInvalidations();
+}
+
+bool QgsQuickMapTileStore::isValid() const
+{
+  return mValid;
+}
+
+QString QgsQuickMapTileStore::path() const
+{
+  return mPath;
+}
+
+QString QgsQuickMapTileStore::storePath( const QString &projectFileName )
+{
+  if ( projectFileName.isEmpty() )
+    return QString();
+
+  const QFileInfo fi( projectFileName );
+  return fi.dir().filePath( QStringLiteral( "%1_tiles.qfieldtiles" ).arg( fi.completeBaseName() ) );
+}
+
+QString QgsQuickMapTileStore::layerStamp( QgsMapLayer *layer )
+{
+  QCryptographicHash hash( QCryptographicHash::Sha1 );
+  hash.addData( layer->source().toUtf8() );
+
+  QgsMapLayerStyle style;
+  style.readFromLayer( layer );
+  hash.addData( style.xmlData().toUtf8() );
+
+  const QVariantMap parts = QgsProviderRegistry::instance()->decodeUri( layer->providerType(), layer->source() );
+  const QFileInfo fi( parts.value( QStringLiteral( "path" ) ).toString() );
+  if ( fi.exists() )
+    hash.addData( fi.lastModified().toString( Qt::ISODateWithMs ).toUtf8() );
+
+  return QString::fromLatin1( hash.result().toHex() );
+}
+
+void QgsQuickMapTileStore::validateLayers( const QList<QgsMapLayer *> &layers )
+{
+  if ( !mValid )
+    return;
+
+  QMutexLocker locker( &mMutex );
+
+  bool invalidated = false;
+  for ( QgsMapLayer *layer : layers )
+  {
+    const QString stamp = layerStamp( layer );
+
+    int status = SQLITE_OK;
+    sqlite3_statement_unique_ptr statement = mDatabase.prepare( QStringLiteral( "SELECT stamp FROM layers WHERE layer_id = ?" ), status );
+    if ( status != SQLITE_OK )
+      continue;
+
+    const QByteArray layerId = layer->id().toUtf8();
+    sqlite3_bind_text( statement.get(), 1, layerId.constData(), layerId.size(), SQLITE_TRANSIENT );
+    if ( statement.step() == SQLITE_ROW && statement.columnAsText( 0 ) == stamp )
+      continue;
+
+    removeLayerTiles( QStringList() << layer->id() );
+    invalidated = true;
+
+    statement = mDatabase.prepare( QStringLiteral( "INSERT OR REPLACE INTO layers ( layer_id, stamp ) VALUES ( ?, ? )" ), status );
+    if ( status != SQLITE_OK )
+      continue;
+
+    const QByteArray stampData = stamp.toUtf8();
+    sqlite3_bind_text( statement.get(), 1, layerId.constData(), layerId.size(), SQLITE_TRANSIENT );
+    sqlite3_bind_text( statement.get(), 2, stampData.constData(), stampData.size(), SQLITE_TRANSIENT );
+    statement.step();
+  }
+
+  if ( invalidated )
+    mGeneration.fetchAndAddOrdered( 1 );
+}
+
+QImage QgsQuickMapTileStore::readTile( const QString &context, qint64 column, qint64 row ) const
+{
+  return readTiles( context, QList<QgsQuickMapTileCache::TileRange>() << QgsQuickMapTileCache::TileRange( column, column, row, row ) ).value( qMakePair( column, row ) );
+}
+
+QgsQuickMapTileStore::TileImages QgsQuickMapTileStore::readTiles( const QString &context, const QList<QgsQuickMapTileCache::TileRange> &ranges ) const
+{
+  TileImages tiles;
+  if ( !mValid )
+    return tiles;
+
+  QHash<QPair<qint64, qint64>, QByteArray> encodedTiles;
+  {
+    QMutexLocker locker( &mMutex );
+
+    // The tiles of invalidated layers are about to be removed
+    if ( isInvalidated( context ) )
+      return tiles;
+
+    const qint64 id = contextId( context, false );
+    if ( id < 0 )
+      return tiles;
+
+    int status = SQLITE_OK;
+    sqlite3_statement_unique_ptr statement = mDatabase.prepare( QStringLiteral( "SELECT tile_column, tile_row, tile_data FROM tiles WHERE context_id = ?"
+                                             " AND tile_column BETWEEN ? AND ? AND tile_row BETWEEN ? AND ?" ), status );
+    if ( status != SQLITE_OK )
+      return tiles;
+
+    for ( const QgsQuickMapTileCache::TileRange &range : ranges )
+    {
+      sqlite3_reset( statement.get() );
+      sqlite3_bind_int64( statement.get(), 1, id );
+      sqlite3_bind_int64( statement.get(), 2, range.firstColumn );
+      sqlite3_bind_int64( statement.get(), 3, range.lastColumn );
+      sqlite3_bind_int64( statement.get(), 4, range.firstRow );
+      sqlite3_bind_int64( statement.get(), 5, range.lastRow );
+      while ( statement.step() == SQLITE_ROW )
+      {
+        const char *data = static_cast<const char *>( sqlite3_column_blob( statement.get(), 2 ) );
+        encodedTiles.insert( qMakePair( statement.columnAsInt64( 0 ), statement.columnAsInt64( 1 ) ),
+                             QByteArray( data, sqlite3_column_bytes( statement.get(), 2 ) ) );
+      }
+    }
+  }
+
+  // Decode outside of the lock, like encoding when writing
+  for ( auto it = encodedTiles.constBegin(); it != encodedTiles.constEnd(); ++it )
+  {
+    QImage tile;
+    if ( tile.loadFromData( it.value(), "PNG" ) )
+      tiles.insert( it.key(), tile.convertToFormat( QImage::Format_ARGB32_Premultiplied ) );
+  }
+
+  return tiles;
+}
+
+void QgsQuickMapTileStore::writeTiles( const QString &context, const QgsQuickMapTileCache::TileRange &range, const QImage &image, int generation )
+{
+  if ( !mValid )
+    return;
+
+  const int tileSize = QgsQuickMapTileCache::TILE_SIZE;
+  if ( image.width() < range.columnCount() * tileSize || image.height() < range.rowCount() * tileSize )
+    return;
+
+  // Encode outside of the lock, this is by far the most expensive part
+  QList<QByteArray> encodedTiles;
+  for ( qint64 row = range.firstRow; row <= range.lastRow; ++row )
+  {
+    for ( qint64 column = range.firstColumn; column <= range.lastColumn; ++column )
+    {
+      QByteArray data;
+      QBuffer buffer( &data );
+      buffer.open( QIODevice::WriteOnly );
+      image.copy( static_cast<int>( ( column - range.firstColumn ) * tileSize ),
+                  static_cast<int>( ( row - range.firstRow ) * tileSize ),
+                  tileSize, tileSize ).save( &buffer, "PNG" );
+      encodedTiles << data;
+    }
+  }
+
+  QMutexLocker locker( &mMutex );
+
+  // A layer has been invalidated while the tiles were rendered or encoded
+  if ( generation != mGeneration.loadAcquire() )
+    return;
+
+  const qint64 id = contextId( context, true );
+  if ( id < 0 )
+    return;
+
+  QString error;
+  mDatabase.exec( QStringLiteral( "BEGIN" ), error );
+
+  int status = SQLITE_OK;
+  sqlite3_statement_unique_ptr statement = mDatabase.prepare( QStringLiteral( "INSERT OR REPLACE INTO tiles ( context_id, tile_column, tile_row, tile_data ) VALUES ( ?, ?, ?, ? )" ), status );
+  if ( status == SQLITE_OK )
+  {
+    int index = 0;
+    for ( qint64 row = range.firstRow; row <= range.lastRow; ++row )
+    {
+      for ( qint64 column = range.firstColumn; column <= range.lastColumn; ++column )
+      {
+        const QByteArray &data = encodedTiles.at( index++ );
+        sqlite3_reset( statement.get() );
+        sqlite3_bind_int64( statement.get(), 1, id );
+        sqlite3_bind_int64( statement.get(), 2, column );
+        sqlite3_bind_int64( statement.get(), 3, row );
+        sqlite3_bind_blob( statement.get(), 4, data.constData(), data.size(), SQLITE_TRANSIENT );
+        statement.step();
+      }
+    }
+  }
+
+  mDatabase.exec( QStringLiteral( "COMMIT" ), error );
+  if ( !error.isEmpty() )
+    QgsMessageLog::logMessage( QObject::tr( "Could not write tiles to tile store %1: %2" ).arg( mPath, error ), QObject::tr( "Rendering" ) );
+}
+
+void QgsQuickMapTileStore::invalidateLayer( const QString &layerId )
+{
+  if ( !mValid )
+    return;
+
+  {
+    QMutexLocker locker( &mInvalidationMutex );
+    mInvalidatedLayers.insert( layerId );
+  }
+  mGeneration.fetchAndAddOrdered( 1 );
+}
+
+void QgsQuickMapTileStore::flushInvalidations()
+{
+  if ( !mValid )
+    return;
+
+  // Readers wait until the tiles are gone, they skip them as long as they are marked as invalidated
+  QMutexLocker locker( &mMutex );
+
+  QSet<QString> layerIds;
+  {
+    QMutexLocker invalidationLocker( &mInvalidationMutex );
+    layerIds.swap( mInvalidatedLayers );
+  }
+
+  if ( !layerIds.isEmpty() )
+    removeLayerTiles( layerIds.values() );
+}
+
+bool QgsQuickMapTileStore::isInvalidated( const QString &context ) const
+{
+  QMutexLocker locker( &mInvalidationMutex );
+  if ( mInvalidatedLayers.isEmpty() )
+    return false;
+
+  const QStringList layerIds = QgsQuickMapTileCache::contextLayerIds( context );
+  for ( const QString &layerId : layerIds )
+  {
+    if ( mInvalidatedLayers.contains( layerId ) )
+      return true;
+  }
+  return false;
+}
+
+int QgsQuickMapTileStore::generation() const
+{
+  return mGeneration.loadAcquire();
+}
+
+qint64 QgsQuickMapTileStore::contextId( const QString &context, bool create ) const
+{
+  const QByteArray contextData = context.toUtf8();
+  int status = SQLITE_OK;
+
+  sqlite3_statement_unique_ptr statement = mDatabase.prepare( QStringLiteral( "SELECT id FROM contexts WHERE context = ?" ), status );
+  if ( status != SQLITE_OK )
+    return -1;
+
+  sqlite3_bind_text( statement.get(), 1, contextData.constData(), contextData.size(), SQLITE_TRANSIENT );
+  if ( statement.step() == SQLITE_ROW )
+    return statement.columnAsInt64( 0 );
+
+  if ( !create )
+    return -1;
+
+  statement = mDatabase.prepare( QStringLiteral( "INSERT INTO contexts ( context ) VALUES ( ? )" ), status );
+  if ( status != SQLITE_OK )
+    return -1;
+
+  sqlite3_bind_text( statement.get(), 1, contextData.constData(), contextData.size(), SQLITE_TRANSIENT );
+  if ( statement.step() != SQLITE_DONE )
+    return -1;
+
+  const qint64 id = sqlite3_last_insert_rowid( mDatabase.get() );
+
+  const QStringList layerIds = QgsQuickMapTileCache::contextLayerIds( context );
+  for ( const QString &layerId : layerIds )
+  {
+    statement = mDatabase.prepare( QStringLiteral( "INSERT INTO context_layers ( context_id, layer_id ) VALUES ( ?, ? )" ), status );
+    if ( status != SQLITE_OK )
+      continue;
+
+    const QByteArray layerIdData = layerId.toUtf8();
+    sqlite3_bind_int64( statement.get(), 1, id );
+    sqlite3_bind_text( statement.get(), 2, layerIdData.constData(), layerIdData.size(), SQLITE_TRANSIENT );
+    statement.step();
+  }
+
+  return id;
+}
+
+void QgsQuickMapTileStore::removeLayerTiles( const QStringList &layerIds )
+{
+  QString error;
+  QStringList quotedLayerIds;
+  for ( const QString &layerId : layerIds )
+    quotedLayerIds << QgsSqliteUtils::quotedString( layerId );
+  const QString contextIds = QStringLiteral( "SELECT context_id FROM context_layers WHERE layer_id IN ( %1 )" ).arg( quotedLayerIds.join( QStringLiteral( ", " ) ) );
+
+  mDatabase.exec( QStringLiteral( "BEGIN;"
+                                  "DELETE FROM tiles WHERE context_id IN ( %1 );"
+                                  "DELETE FROM contexts WHERE id IN ( %1 );"
+                                  "DELETE FROM context_layers WHERE context_id IN ( %1 );"
+                                  "COMMIT;" ).arg( contextIds ), error );
+  if ( !error.isEmpty() )
+  {
+    QgsMessageLog::logMessage( QObject::tr( "Could not invalidate tile store %1: %2" ).arg( mPath, error ), QObject::tr( "Rendering" ) );
+    mDatabase.exec( QStringLiteral( "ROLLBACK" ), error );
+  }
+}
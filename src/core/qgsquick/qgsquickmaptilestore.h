@@ -0,0 +1,115 @@
+/***************************************************************************
+  qgsquickmaptilestore.h
+  --------------------------------------
+  Date                 : 16.10.2026
+  Copyright            : (C) 2026 by QField contributors
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef QGSQUICKMAPTILESTORE_H
+#define QGSQUICKMAPTILESTORE_H
+
+#include <QAtomicInt>
+#include <QHash>
+#include <QImage>
+#include <QMutex>
+#include <QPair>
+#include <QSet>
+#include <QString>
+
+#include <qgssqliteutils.h>
+
+#include "qgsquickmaptilecache.h"
+
+class QgsMapLayer;
+
+/**
+ * The QgsQuickMapTileStore class persists rendered map tiles in an sqlite database
+ * stored next to the project file, so they survive a project reload or an application restart.
+ *
+ * Tiles are grouped by the context keys of QgsQuickMapTileCache. Every layer gets a stamp made of
+ * its source, its style and the modification time of its data file. Tiles of layers whose stamp
+ * changed since the last session are discarded when the store is validated.
+ *
+ * All methods are thread safe, tiles are usually read and written from worker threads.
+ */
+class QgsQuickMapTileStore
+{
+  public:
+
+    //! Tile images by column and row
+    typedef QHash<QPair<qint64, qint64>, QImage> TileImages;
+
+    /**
+     * Opens or creates the tile store database at \a path.
+     */
+    explicit QgsQuickMapTileStore( const QString &path );
+
+    //! Removes the tiles of layers invalidated since the last flush
+    ~QgsQuickMapTileStore();
+
+    //! Returns TRUE if the database could be opened
+    bool isValid() const;
+
+    //! Returns the path to the database
+    QString path() const;
+
+    //! Returns the path of the tile store which belongs to the project at \a projectFileName
+    static QString storePath( const QString &projectFileName );
+
+    //! Returns a stamp which changes whenever the rendered output of \a layer may have changed outside of the application
+    static QString layerStamp( QgsMapLayer *layer );
+
+    /**
+     * Compares the stamps of \a layers with the ones recorded in the database,
+     * drops the tiles of each layer whose stamp changed and records the new stamps.
+     */
+    void validateLayers( const QList<QgsMapLayer *> &layers );
+
+    //! Returns the tile at \a column and \a row for \a context or a null image if it is not stored
+    QImage readTile( const QString &context, qint64 column, qint64 row ) const;
+
+    //! Returns the tiles stored for \a context within \a ranges
+    TileImages readTiles( const QString &context, const QList<QgsQuickMapTileCache::TileRange> &ranges ) const;
+
+    /**
+     * Splits an \a image rendered for the tiles in \a range and stores them for \a context.
+     * Nothing is written if the store has been invalidated after \a generation was retrieved.
+     */
+    void writeTiles( const QString &context, const QgsQuickMapTileCache::TileRange &range, const QImage &image, int generation );
+
+    /**
+     * Marks all tiles of contexts including the layer with \a layerId as outdated. They are not read anymore
+     * and removed from the database on the next call to flushInvalidations(), so layers which are repainted
+     * often only cost a single deletion.
+     */
+    void invalidateLayer( const QString &layerId );
+
+    //! Removes the tiles of all layers invalidated since the last flush from the database
+    void flushInvalidations();
+
+    //! Returns the current generation, incremented on every invalidation
+    int generation() const;
+
+  private:
+    qint64 contextId( const QString &context, bool create ) const;
+    bool isInvalidated( const QString &context ) const;
+    void removeLayerTiles( const QStringList &layerIds );
+
+    mutable QMutex mMutex;
+    //! Guards mInvalidatedLayers only, so invalidating never waits for the database
+    mutable QMutex mInvalidationMutex;
+    QSet<QString> mInvalidatedLayers;
+    sqlite3_database_unique_ptr mDatabase;
+    QString mPath;
+    bool mValid = false;
+    QAtomicInt mGeneration;
+};
+
+#endif // QGSQUICKMAPTILESTORE_H
@@ -45,15 +45,20 @@ void QgsQuickMapTransform::setMapSettings( QgsQuickMapSettings *mapSettings )
   emit mapSettingsChanged();
 }
 
-void QgsQuickMapTransform::updateMatrix()
+QMatrix4x4 QgsQuickMapTransform::matrix( const QgsQuickMapSettings *mapSettings, const QgsPointXY &origin )
 {
-  QMatrix4x4 matrix;
-  float scaleFactor = static_cast<float>( 1.0 / mMapSettings->mapUnitsPerPoint() );
+  const double scaleFactor = 1.0 / mapSettings->mapUnitsPerPoint();
+  const QgsRectangle visibleExtent = mapSettings->visibleExtent();
 
-  matrix.scale( scaleFactor, -scaleFactor );
-  matrix.translate( static_cast<float>( -mMapSettings->visibleExtent().xMinimum( ) ),
-                    static_cast<float>( -mMapSettings->visibleExtent().yMaximum() ) );
+  // Only the resulting offset of the origin on the screen is converted to float
+  return QMatrix4x4( static_cast<float>( scaleFactor ), 0, 0, static_cast<float>( ( origin.x() - visibleExtent.xMinimum() ) * scaleFactor ),
+                     0, static_cast<float>( -scaleFactor ), 0, static_cast<float>( ( visibleExtent.yMaximum() - origin.y() ) * scaleFactor ),
+                     0, 0, 1, 0,
+                     0, 0, 0, 1 );
+}
 
-  mMatrix = matrix;
+void QgsQuickMapTransform::updateMatrix()
+{
+  mMatrix = matrix( mMapSettings );
   update();
 }
@@ -19,6 +19,8 @@
 #include <QQuickItem>
 #include <QMatrix4x4>
 
+#include <qgspointxy.h>
+
 
 class QgsQuickMapSettings;
 
@@ -53,6 +55,16 @@ class QgsQuickMapTransform : public QQuickTransform
      */
     void applyTo( QMatrix4x4 *matrix ) const;
 
+    /**
+     * Returns the matrix transforming map coordinates relative to \a origin to device coordinates
+     * based on \a mapSettings.
+     *
+     * The matrix is computed in double precision and only converted to float at the end. Vertices stored
+     * relative to a nearby origin therefore keep their precision even with large map coordinates, e.g. in
+     * LV95 or UTM, where absolute float coordinates would jitter.
+     */
+    static QMatrix4x4 matrix( const QgsQuickMapSettings *mapSettings, const QgsPointXY &origin = QgsPointXY( 0, 0 ) );
+
     //! \copydoc QgsQuickMapTransform::mapSettings
     QgsQuickMapSettings *mapSettings() const;
 
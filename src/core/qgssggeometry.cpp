@@ -15,9 +15,7 @@
 #include "math.h"
 
 #include "qgssggeometry.h"
-extern "C" {
-#include "tessellate.h"
-}
+#include "qgssgtessellator.h"
 
 
 QgsSGGeometry::QgsSGGeometry()
@@ -25,6 +23,11 @@ QgsSGGeometry::QgsSGGeometry()
 }
 
 QgsSGGeometry::QgsSGGeometry( const QgsGeometry &geom, const QColor &color, int width )
+  : QgsSGGeometry( geom, QgsSGTessellator::tessellate( geom ), color, width )
+{
+}
+
+QgsSGGeometry::QgsSGGeometry( const QgsGeometry &geom, const QVector<QgsPointXY> &triangles, const QColor &color, int width, const QgsPointXY &origin )
 {
   //TODO: Fix const-correcteness upstream
   QgsGeometry &gg = const_cast<QgsGeometry &>( geom );
@@ -46,7 +49,7 @@ QgsSGGeometry::QgsSGGeometry( const QgsGeometry &geom, const QColor &color, int
         for ( const QgsPolylineXY &line : lines )
         {
           QSGGeometryNode *geomNode = new QSGGeometryNode;
-          geomNode->setGeometry( qgsPolylineToQSGGeometry( line, width ) );
+          geomNode->setGeometry( qgsPolylineToQSGGeometry( line, width, origin ) );
           geomNode->setFlag( QSGNode::OwnsGeometry );
           applyStyle( geomNode );
           appendChildNode( geomNode );
@@ -55,7 +58,7 @@ QgsSGGeometry::QgsSGGeometry( const QgsGeometry &geom, const QColor &color, int
       else
       {
         QSGGeometryNode *geomNode = new QSGGeometryNode;
-        geomNode->setGeometry( qgsPolylineToQSGGeometry( gg.asPolyline(), width ) );
+        geomNode->setGeometry( qgsPolylineToQSGGeometry( gg.asPolyline(), width, origin ) );
         geomNode->setFlag( QSGNode::OwnsGeometry );
         applyStyle( geomNode );
         appendChildNode( geomNode );
@@ -63,47 +66,31 @@ QgsSGGeometry::QgsSGGeometry( const QgsGeometry &geom, const QColor &color, int
       break;
 
     case QgsWkbTypes::PolygonGeometry:
-      if ( gg.isMultipart() )
+    {
+      QSGOpacityNode *on = new QSGOpacityNode;
+      on->setOpacity( 0.5 );
+      QSGGeometryNode *geomNode = new QSGGeometryNode;
+      geomNode->setGeometry( qgsTrianglesToQSGGeometry( triangles, origin ) );
+      geomNode->setFlag( QSGNode::OwnsGeometry );
+      applyStyle( geomNode );
+      on->appendChildNode( geomNode );
+      appendChildNode( on );
+
+      const QgsMultiPolygonXY polygons = gg.isMultipart() ? gg.asMultiPolygon() : QgsMultiPolygonXY() << gg.asPolygon();
+      for ( const QgsPolygonXY &polygon : polygons )
       {
-        const QgsMultiPolygonXY polygons = gg.asMultiPolygon();
-
-        QSGOpacityNode *on = new QSGOpacityNode;
-        on->setOpacity( 0.5 );
-
-        for ( const QgsPolygonXY &polygon : polygons )
+        // outline the interior rings too, they are left empty by the tessellation
+        for ( const QgsPolylineXY &ring : polygon )
         {
-          QSGGeometryNode *geomNode = new QSGGeometryNode;
-          geomNode->setGeometry( qgsPolygonToQSGGeometry( polygon ) );
-          geomNode->setFlag( QSGNode::OwnsGeometry );
-          applyStyle( geomNode );
-          on->appendChildNode( geomNode );
-
           geomNode = new QSGGeometryNode;
-          geomNode->setGeometry( qgsPolylineToQSGGeometry( polygon.first(), width ) );
+          geomNode->setGeometry( qgsPolylineToQSGGeometry( ring, width, origin ) );
           geomNode->setFlag( QSGNode::OwnsGeometry );
           applyStyle( geomNode );
           appendChildNode( geomNode );
         }
-
-        appendChildNode( on );
-      }
-      else
-      {
-        QSGOpacityNode *on = new QSGOpacityNode;
-        on->setOpacity( 0.5 );
-        QSGGeometryNode *geomNode = new QSGGeometryNode;
-        geomNode->setGeometry( qgsPolygonToQSGGeometry( gg.asPolygon() ) );
-        geomNode->setFlag( QSGNode::OwnsGeometry );
-        applyStyle( geomNode );
-        on->appendChildNode( geomNode );
-        appendChildNode( on );
-        geomNode = new QSGGeometryNode;
-        geomNode->setGeometry( qgsPolylineToQSGGeometry( gg.asPolygon().first(), width ) );
-        geomNode->setFlag( QSGNode::OwnsGeometry );
-        applyStyle( geomNode );
-        appendChildNode( geomNode );
       }
       break;
+    }
 
     default:
       // Nothing to do
@@ -116,7 +103,7 @@ void QgsSGGeometry::applyStyle( QSGGeometryNode *geomNode )
   geomNode->setMaterial( &mMaterial );
 }
 
-QSGGeometry *QgsSGGeometry::qgsPolylineToQSGGeometry( const QgsPolylineXY &line, int width )
+QSGGeometry *QgsSGGeometry::qgsPolylineToQSGGeometry( const QgsPolylineXY &line, int width, const QgsPointXY &origin )
 {
   QSGGeometry *sgGeom = new QSGGeometry( QSGGeometry::defaultAttributes_Point2D(), line.count() );
   QSGGeometry::Point2D *vertices = sgGeom->vertexDataAsPoint2D();
@@ -124,7 +111,7 @@ QSGGeometry *QgsSGGeometry::qgsPolylineToQSGGeometry( const QgsPolylineXY &line,
   int i = 0;
   for ( const QgsPointXY &pt : line )
   {
-    vertices[i].set( static_cast<float>( pt.x() ), static_cast<float>( pt.y() ) );
+    vertices[i].set( static_cast<float>( pt.x() - origin.x() ), static_cast<float>( pt.y() - origin.y() ) );
     i++;
   }
 
@@ -134,44 +121,18 @@ QSGGeometry *QgsSGGeometry::qgsPolylineToQSGGeometry( const QgsPolylineXY &line,
   return sgGeom;
 }
 
-QSGGeometry *QgsSGGeometry::qgsPolygonToQSGGeometry( const QgsPolygonXY &polygon )
+QSGGeometry *QgsSGGeometry::qgsTrianglesToQSGGeometry( const QVector<QgsPointXY> &triangles, const QgsPointXY &origin )
 {
-  QgsPolygonXY::ConstIterator it = polygon.constBegin();
-
-  double *coordinates_out;
-  int *tris_out;
-  int nverts, ntris;
-
-  const QgsPolylineXY &ring = *it;
-
-  double *vertices_in = ( double * )malloc( ring.size() * 2 * sizeof( double ) );
-  const double *contours_array[] = { vertices_in, vertices_in + ring.size() * 2 };
-  int i = 0;
-
-  for ( const QgsPointXY &point : ring )
-  {
-    vertices_in[i++] = point.x();
-    vertices_in[i++] = point.y();
-  }
-
-  tessellate( &coordinates_out, &nverts,
-              &tris_out, &ntris,
-              contours_array, contours_array + 2 );
-
-  QSGGeometry *sgGeom = new QSGGeometry( QSGGeometry::defaultAttributes_Point2D(), ntris * 3 );
-
+  QSGGeometry *sgGeom = new QSGGeometry( QSGGeometry::defaultAttributes_Point2D(), triangles.size() );
   QSGGeometry::Point2D *vertices = sgGeom->vertexDataAsPoint2D();
 
-  for ( int j = 0; j < ntris * 3; j++ )
+  int i = 0;
+  for ( const QgsPointXY &pt : triangles )
   {
-    vertices[j].x = coordinates_out[tris_out[j] * 2];
-    vertices[j].y = coordinates_out[tris_out[j] * 2 + 1];
+    vertices[i].set( static_cast<float>( pt.x() - origin.x() ), static_cast<float>( pt.y() - origin.y() ) );
+    i++;
   }
 
-  free( vertices_in );
-  free( coordinates_out );
-  free( tris_out );
-
   sgGeom->setDrawingMode( QSGGeometry::DrawTriangles );
 
   return sgGeom;
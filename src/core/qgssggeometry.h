@@ -26,11 +26,18 @@ class QgsSGGeometry : public QSGNode
     QgsSGGeometry();
     QgsSGGeometry( const QgsGeometry &geom, const QColor &color, int width );
 
+    /**
+     * Creates the nodes for \a geom using the already tessellated \a triangles of its polygons.
+     * The vertices are stored relative to \a origin, which should be close to the geometry to keep float precision.
+     * \see QgsSGTessellator
+     */
+    QgsSGGeometry( const QgsGeometry &geom, const QVector<QgsPointXY> &triangles, const QColor &color, int width, const QgsPointXY &origin = QgsPointXY( 0, 0 ) );
+
   private:
     void applyStyle( QSGGeometryNode *geomNode );
 
-    static QSGGeometry *qgsPolylineToQSGGeometry( const QgsPolylineXY &line, int width );
-    static QSGGeometry *qgsPolygonToQSGGeometry( const QgsPolygonXY &polygon );
+    static QSGGeometry *qgsPolylineToQSGGeometry( const QgsPolylineXY &line, int width, const QgsPointXY &origin );
+    static QSGGeometry *qgsTrianglesToQSGGeometry( const QVector<QgsPointXY> &triangles, const QgsPointXY &origin );
 
     QSGFlatColorMaterial mMaterial;
 };
@@ -0,0 +1,186 @@
+/***************************************************************************
+    qgssgtessellator.cpp
+    ---------------------
+    begin                : October 2026
+    copyright            : (C) 2026 by QField contributors
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+#include <QMutexLocker>
+
+#include <cmath>
+#include <memory>
+
+#include <qgscoordinatetransform.h>
+#include <qgsexception.h>
+#include <qgsmessagelog.h>
+#include <qgsproject.h>
+
+#include "qgssgtessellator.h"
+#include "coordinatetransformcache.h"
+extern "C" {
+#include "tessellate.h"
+}
+
+
+static QString crsKey( const QgsCoordinateReferenceSystem &crs )
+{
+  return crs.authid().isEmpty() ? crs.toWkt() : crs.authid();
+}
+
+QgsSGTessellator::QgsSGTessellator( int maxCost )
+{
+  mTessellations.setMaxCost( maxCost );
+}
+
+QgsSGTessellator *QgsSGTessellator::instance()
+{
+  static QgsSGTessellator *sTessellator = []
+  {
+    QgsSGTessellator *tessellator = new QgsSGTessellator;
+    QObject::connect( QgsProject::instance(), &QgsProject::transformContextChanged, QgsProject::instance(), [tessellator] { tessellator->clear(); } );
+    return tessellator;
+  }();
+  return sTessellator;
+}
+
+int QgsSGTessellator::levelOfDetail( double mapUnitsPerPoint )
+{
+  if ( !std::isfinite( mapUnitsPerPoint ) || mapUnitsPerPoint <= 0 )
+    return FullDetail;
+
+  return static_cast<int>( std::floor( std::log2( mapUnitsPerPoint ) ) );
+}
+
+double QgsSGTessellator::simplificationTolerance( int levelOfDetail )
+{
+  if ( levelOfDetail == FullDetail )
+    return 0;
+
+  // The level covers map units per point from 2^level to 2^(level + 1)
+  return std::ldexp( 0.5, levelOfDetail );
+}
+
+QVector<QgsPointXY> QgsSGTessellator::tessellate( const QgsPolygonXY &polygon )
+{
+  QVector<QgsPointXY> triangles;
+
+  int vertexCount = 0;
+  for ( const QgsPolylineXY &ring : polygon )
+    vertexCount += ring.size();
+
+  if ( vertexCount < 3 )
+    return triangles;
+
+  double *coordinates_out;
+  int *tris_out;
+  int nverts, ntris;
+
+  // One contour per ring, contour i spans from contours_array[i] to contours_array[i + 1]
+  double *vertices_in = ( double * )malloc( vertexCount * 2 * sizeof( double ) );
+  QVector<const double *> contours_array;
+  contours_array.reserve( polygon.size() + 1 );
+  int i = 0;
+
+  for ( const QgsPolylineXY &ring : polygon )
+  {
+    contours_array << vertices_in + i;
+    for ( const QgsPointXY &point : ring )
+    {
+      vertices_in[i++] = point.x();
+      vertices_in[i++] = point.y();
+    }
+  }
+  contours_array << vertices_in + i;
+
+  tessellate( &coordinates_out, &nverts,
+              &tris_out, &ntris,
+              contours_array.data(), contours_array.data() + contours_array.size() );
+
+  triangles.reserve( ntris * 3 );
+  for ( int j = 0; j < ntris * 3; j++ )
+  {
+    triangles << QgsPointXY( coordinates_out[tris_out[j] * 2], coordinates_out[tris_out[j] * 2 + 1] );
+  }
+
+  free( vertices_in );
+  free( coordinates_out );
+  free( tris_out );
+
+  return triangles;
+}
+
+QVector<QgsPointXY> QgsSGTessellator::tessellate( const QgsGeometry &geometry )
+{
+  if ( geometry.type() != QgsWkbTypes::PolygonGeometry )
+    return QVector<QgsPointXY>();
+
+  if ( !geometry.isMultipart() )
+    return tessellate( geometry.asPolygon() );
+
+  QVector<QgsPointXY> triangles;
+  const QgsMultiPolygonXY polygons = geometry.asMultiPolygon();
+  for ( const QgsPolygonXY &polygon : polygons )
+    triangles << tessellate( polygon );
+
+  return triangles;
+}
+
+QgsSGTessellator::Tessellation QgsSGTessellator::tessellation( const QgsGeometry &geometry, const QgsCoordinateReferenceSystem &crs,
+    const QgsCoordinateReferenceSystem &destinationCrs, const QgsCoordinateTransformContext &transformContext, int levelOfDetail )
+{
+  if ( geometry.type() == QgsWkbTypes::PointGeometry )
+    levelOfDetail = FullDetail;
+
+  const CacheKey key { geometry.asWkb(), crsKey( crs ), crsKey( destinationCrs ), levelOfDetail };
+
+  {
+    QMutexLocker locker( &mMutex );
+    const Entry *cached = mTessellations.object( key );
+    if ( cached && cached->transformContext == transformContext )
+      return cached->tessellation;
+  }
+
+  std::unique_ptr<Entry> entry( new Entry { transformContext, Tessellation() } );
+  Tessellation *result = &entry->tessellation;
+  result->geometry = geometry;
+  try
+  {
+    const QgsCoordinateTransform ct = CoordinateTransformCache::instance()->transform( crs, destinationCrs, transformContext );
+    result->geometry.transform( ct );
+  }
+  catch ( const QgsCsException &e )
+  {
+    QgsMessageLog::logMessage( QStringLiteral( "Transformation error occurred: %1" ).arg( e.what() ) );
+    return Tessellation();
+  }
+
+  if ( levelOfDetail != FullDetail )
+  {
+    // Topology preserving, a simplification which collapses the geometry keeps the original
+    const QgsGeometry simplified = result->geometry.simplify( simplificationTolerance( levelOfDetail ) );
+    if ( !simplified.isNull() && !simplified.isEmpty() )
+      result->geometry = simplified;
+  }
+
+  result->triangles = tessellate( result->geometry );
+
+  const Tessellation tessellation = *result;
+  const int cost = result->triangles.size() + static_cast<int>( key.wkb.size() / ( 2 * sizeof( double ) ) );
+
+  QMutexLocker locker( &mMutex );
+  mTessellations.insert( key, entry.release(), cost );
+
+  return tessellation;
+}
+
+void QgsSGTessellator::clear()
+{
+  QMutexLocker locker( &mMutex );
+  mTessellations.clear();
+}
@@ -0,0 +1,126 @@
+/***************************************************************************
+    qgssgtessellator.h
+    ---------------------
+    begin                : October 2026
+    copyright            : (C) 2026 by QField contributors
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+#ifndef QGSSGTESSELLATOR_H
+#define QGSSGTESSELLATOR_H
+
+#include <QByteArray>
+#include <QCache>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+
+#include <limits>
+
+#include <qgscoordinatereferencesystem.h>
+#include <qgscoordinatetransformcontext.h>
+#include <qgsgeometry.h>
+
+/**
+ * The QgsSGTessellator class triangulates polygons to be drawn on the scene graph.
+ *
+ * All rings of a polygon are passed to the tessellator with the odd winding rule,
+ * interior rings are therefore left empty. Multipolygons are triangulated part by part.
+ *
+ * Tessellations of highlighted geometries are kept in a bounded least recently used
+ * cache keyed by the geometry, its CRS and the destination CRS. Highlighting the same
+ * geometry again only costs a lookup. A cached tessellation is only reused with the
+ * transform context it was transformed with.
+ *
+ * At small scales, geometries can be simplified to a level of detail derived from the
+ * map units per point. Levels are powers of two, each level is cached separately and
+ * zooming only triggers a new simplification once it crosses into another level.
+ */
+class QgsSGTessellator
+{
+  public:
+    //! A geometry transformed to the destination CRS together with the triangles of its polygons
+    struct Tessellation
+    {
+      QgsGeometry geometry;
+      //! Three consecutive vertices per triangle
+      QVector<QgsPointXY> triangles;
+    };
+
+    /**
+     * Creates a new tessellator which caches up to \a maxCost vertices of geometries and triangles.
+     */
+    explicit QgsSGTessellator( int maxCost = 1000000 );
+
+    //! Level of detail of geometries which are not simplified
+    static constexpr int FullDetail = std::numeric_limits<int>::min();
+
+    //! Returns the tessellator shared by all highlights, it is cleared when the project transform context changes
+    static QgsSGTessellator *instance();
+
+    //! Returns the triangles of all rings of a \a polygon
+    static QVector<QgsPointXY> tessellate( const QgsPolygonXY &polygon );
+
+    //! Returns the triangles of all parts and rings of a polygon or multipolygon \a geometry
+    static QVector<QgsPointXY> tessellate( const QgsGeometry &geometry );
+
+    /**
+     * Returns the level of detail for a map showing \a mapUnitsPerPoint, all scales within a factor
+     * of two share the same level.
+     */
+    static int levelOfDetail( double mapUnitsPerPoint );
+
+    /**
+     * Returns the tolerance in map units used to simplify geometries for a \a levelOfDetail.
+     * The deviation stays below half a point at all scales of the level.
+     */
+    static double simplificationTolerance( int levelOfDetail );
+
+    /**
+     * Returns the \a geometry in \a crs transformed to \a destinationCrs and, for polygons, its triangles.
+     * Unless \a levelOfDetail is FullDetail, the transformed geometry is simplified to this level first.
+     * The result is cached, the transformation and tessellation only run on the first call for a geometry and level.
+     */
+    Tessellation tessellation( const QgsGeometry &geometry, const QgsCoordinateReferenceSystem &crs,
+                               const QgsCoordinateReferenceSystem &destinationCrs, const QgsCoordinateTransformContext &transformContext,
+                               int levelOfDetail = FullDetail );
+
+    //! Removes all tessellations from the cache
+    void clear();
+
+    //! Identifies a geometry in a CRS transformed to a destination CRS
+    struct CacheKey
+    {
+      QByteArray wkb;
+      QString crs;
+      QString destinationCrs;
+      int levelOfDetail;
+
+      bool operator==( const CacheKey &other ) const
+      {
+        return levelOfDetail == other.levelOfDetail && crs == other.crs && destinationCrs == other.destinationCrs && wkb == other.wkb;
+      }
+    };
+
+  private:
+    struct Entry
+    {
+      QgsCoordinateTransformContext transformContext;
+      Tessellation tessellation;
+    };
+
+    QCache<CacheKey, Entry> mTessellations;
+    QMutex mMutex;
+};
+
+inline uint qHash( const QgsSGTessellator::CacheKey &key, uint seed = 0 )
+{
+  return qHash( key.wkb, seed ) ^ qHash( key.crs, seed ) ^ ( qHash( key.destinationCrs, seed ) << 1 ) ^ qHash( key.levelOfDetail, seed );
+}
+
+#endif // QGSSGTESSELLATOR_H
@@ -20,6 +20,10 @@
 
 #include "rubberbandmodel.h"
 #include "sgrubberband.h"
+#include "qgsquickmapsettings.h"
+#include "qgsquickmaptransform.h"
+
+#include <algorithm>
 
 Rubberband::Rubberband( QQuickItem *parent )
   : QQuickItem( parent )
@@ -43,9 +47,10 @@ void Rubberband::setModel( RubberbandModel *model )
 
   if ( mRubberbandModel )
   {
-    disconnect( mRubberbandModel, &RubberbandModel::vertexChanged, this, &Rubberband::markDirty );
-    disconnect( mRubberbandModel, &RubberbandModel::verticesRemoved, this, &Rubberband::markDirty );
-    disconnect( mRubberbandModel, &RubberbandModel::verticesInserted, this, &Rubberband::markDirty );
+    disconnect( mRubberbandModel, &RubberbandModel::vertexChanged, this, &Rubberband::onVertexChanged );
+    disconnect( mRubberbandModel, &RubberbandModel::verticesRemoved, this, &Rubberband::onVerticesChanged );
+    disconnect( mRubberbandModel, &RubberbandModel::verticesInserted, this, &Rubberband::onVerticesChanged );
+    disconnect( mRubberbandModel, &RubberbandModel::currentCoordinateIndexChanged, this, &Rubberband::update );
   }
 
 
@@ -53,9 +58,10 @@ void Rubberband::setModel( RubberbandModel *model )
 
   if ( mRubberbandModel )
   {
-    connect( mRubberbandModel, &RubberbandModel::vertexChanged, this, &Rubberband::markDirty );
-    connect( mRubberbandModel, &RubberbandModel::verticesRemoved, this, &Rubberband::markDirty );
-    connect( mRubberbandModel, &RubberbandModel::verticesInserted, this, &Rubberband::markDirty );
+    connect( mRubberbandModel, &RubberbandModel::vertexChanged, this, &Rubberband::onVertexChanged );
+    connect( mRubberbandModel, &RubberbandModel::verticesRemoved, this, &Rubberband::onVerticesChanged );
+    connect( mRubberbandModel, &RubberbandModel::verticesInserted, this, &Rubberband::onVerticesChanged );
+    connect( mRubberbandModel, &RubberbandModel::currentCoordinateIndexChanged, this, &Rubberband::update );
   }
 
   markDirty();
@@ -108,7 +114,14 @@ void Rubberband::setMapSettings( QgsQuickMapSettings *mapSettings )
   if ( mMapSettings == mapSettings )
     return;
 
+  if ( mMapSettings )
+    disconnect( mMapSettings, &QgsQuickMapSettings::visibleExtentChanged, this, &Rubberband::onVisibleExtentChanged );
+
   mMapSettings = mapSettings;
+
+  if ( mMapSettings )
+    connect( mMapSettings, &QgsQuickMapSettings::visibleExtentChanged, this, &Rubberband::onVisibleExtentChanged );
+
   markDirty();
 
   emit mapSettingsChanged();
@@ -120,48 +133,97 @@ void Rubberband::markDirty()
   update();
 }
 
+void Rubberband::onVertexChanged( int index )
+{
+  mDirtyFrom = std::min( mDirtyFrom, index );
+  // Moving the current point does not change the rubberband without it
+  if ( index != mRubberbandModel->currentCoordinateIndex() )
+    mDirtyFromSkipCurrent = std::min( mDirtyFromSkipCurrent, std::max( 0, index - 1 ) );
+  update();
+}
+
+void Rubberband::onVerticesChanged( int index )
+{
+  mDirtyFrom = std::min( mDirtyFrom, index );
+  mDirtyFromSkipCurrent = std::min( mDirtyFromSkipCurrent, std::max( 0, index - 1 ) );
+  update();
+}
+
+void Rubberband::onVisibleExtentChanged()
+{
+  // Only the transform of the nodes changes, the vertices are kept
+  if ( mLocalOrigin )
+    update();
+}
+
 QSGNode *Rubberband::updatePaintNode( QSGNode *n, QQuickItem::UpdatePaintNodeData * )
 {
-  if ( mDirty )
+  bool frozen = mRubberbandModel && mRubberbandModel->frozen();
+
+  QVector<QgsPoint> vertices;
+  QgsWkbTypes::GeometryType geomType = QgsWkbTypes::LineGeometry;
+  int currentCoordinateIndex = -1;
+
+  if ( mRubberbandModel && !mRubberbandModel->isEmpty() )
   {
-    delete n;
-    n = new QSGNode;
+    // Implicitly shared, the nodes only convert the points which changed
+    vertices = mRubberbandModel->vertices();
+    geomType = mRubberbandModel->geometryType();
+    if ( !frozen )
+      currentCoordinateIndex = mRubberbandModel->currentCoordinateIndex();
+  }
+  else if ( mVertexModel && mVertexModel->vertexCount() > 0 )
+  {
+    vertices = mVertexModel->flatVertices();
+    geomType = mVertexModel->geometryType();
+  }
 
-    bool frozen = mRubberbandModel && mRubberbandModel->frozen();
+  SGRubberband *rb = n ? static_cast<SGRubberband *>( n->firstChild() ) : nullptr;
+  SGRubberband *rbCurrentPoint = rb ? static_cast<SGRubberband *>( rb->nextSibling() ) : nullptr;
 
-    QVector<QgsPoint> allVertices = QVector<QgsPoint>();
-    QVector<QgsPoint> allButCurrentVertices = QVector<QgsPoint>();
-    QgsWkbTypes::GeometryType geomType = QgsWkbTypes::LineGeometry;
+  if ( mDirty || vertices.isEmpty() || !rb || rb->type() != geomType || ( rbCurrentPoint != nullptr ) != ( currentCoordinateIndex >= 0 ) )
+  {
+    delete n;
+    n = mLocalOrigin ? new QSGTransformNode : new QSGNode;
 
-    if ( mRubberbandModel && !mRubberbandModel->isEmpty() )
-    {
-      allVertices = mRubberbandModel->flatVertices();
-      geomType = mRubberbandModel->geometryType();
-      if ( !frozen )
-        allButCurrentVertices = mRubberbandModel->flatVertices( true );
-    }
-    else if ( mVertexModel && mVertexModel->vertexCount() > 0 )
+    if ( !vertices.isEmpty() )
     {
-      allVertices = mVertexModel->flatVertices();
-      geomType = mVertexModel->geometryType();
-    }
+      mOrigin = mLocalOrigin ? QgsPointXY( vertices.first().x(), vertices.first().y() ) : QgsPointXY( 0, 0 );
 
-    if ( !allVertices.isEmpty() )
-    {
-      SGRubberband *rb = new SGRubberband( allVertices, geomType, mColor, mWidth );
+      rb = new SGRubberband( geomType, mColor, mWidth, mOrigin );
+      rb->setVertices( vertices );
       rb->setFlag( QSGNode::OwnedByParent );
       n->appendChildNode( rb );
 
-      if ( !frozen )
+      if ( currentCoordinateIndex >= 0 )
       {
-        SGRubberband *rbCurrentPoint = new SGRubberband( allButCurrentVertices, geomType, mColorCurrentPoint, mWidthCurrentPoint );
+        rbCurrentPoint = new SGRubberband( geomType, mColorCurrentPoint, mWidthCurrentPoint, mOrigin );
+        rbCurrentPoint->setVertices( vertices, 0, currentCoordinateIndex );
         rbCurrentPoint->setFlag( QSGNode::OwnedByParent );
         n->appendChildNode( rbCurrentPoint );
       }
     }
   }
+  else
+  {
+    if ( mDirtyFrom != std::numeric_limits<int>::max() )
+      rb->setVertices( vertices, mDirtyFrom );
+
+    // The vertices before both the previous and the new current point did not change
+    int dirtyFromSkipCurrent = mDirtyFromSkipCurrent;
+    if ( currentCoordinateIndex != mCurrentCoordinateIndex )
+      dirtyFromSkipCurrent = std::min( dirtyFromSkipCurrent, std::min( currentCoordinateIndex, mCurrentCoordinateIndex ) );
+    if ( rbCurrentPoint && dirtyFromSkipCurrent != std::numeric_limits<int>::max() )
+      rbCurrentPoint->setVertices( vertices, dirtyFromSkipCurrent, currentCoordinateIndex );
+  }
+
+  if ( mLocalOrigin && mMapSettings )
+    static_cast<QSGTransformNode *>( n )->setMatrix( QgsQuickMapTransform::matrix( mMapSettings, mOrigin ) );
 
   mDirty = false;
+  mDirtyFrom = std::numeric_limits<int>::max();
+  mDirtyFromSkipCurrent = std::numeric_limits<int>::max();
+  mCurrentCoordinateIndex = currentCoordinateIndex;
   return n;
 }
 
@@ -176,6 +238,7 @@ void Rubberband::setWidth( qreal width )
     return;
 
   mWidth = width;
+  markDirty();
 
   emit widthChanged();
 }
@@ -191,6 +254,7 @@ void Rubberband::setColor( const QColor &color )
     return;
 
   mColor = color;
+  markDirty();
 
   emit colorChanged();
 }
@@ -206,6 +270,7 @@ void Rubberband::setWidthCurrentPoint( qreal width )
     return;
 
   mWidthCurrentPoint = width;
+  markDirty();
 
   emit widthCurrentPointChanged();
 }
@@ -221,7 +286,23 @@ void Rubberband::setColorCurrentPoint( const QColor &color )
     return;
 
   mColorCurrentPoint = color;
+  markDirty();
 
   emit colorCurrentPointChanged();
 }
 
+bool Rubberband::localOrigin() const
+{
+  return mLocalOrigin;
+}
+
+void Rubberband::setLocalOrigin( bool localOrigin )
+{
+  if ( mLocalOrigin == localOrigin )
+    return;
+
+  mLocalOrigin = localOrigin;
+  markDirty();
+
+  emit localOriginChanged();
+}
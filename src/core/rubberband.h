@@ -18,6 +18,10 @@
 
 #include <QQuickItem>
 
+#include <limits>
+
+#include <qgspointxy.h>
+
 class RubberbandModel;
 class VertexModel;
 class QgsQuickMapSettings;
@@ -43,6 +47,14 @@ class Rubberband : public QQuickItem
     //! Line width  of the aleternative rubberband for current point
     Q_PROPERTY( qreal widthCurrentPoint READ widthCurrentPoint WRITE setWidthCurrentPoint NOTIFY widthCurrentPointChanged )
 
+    /**
+     * When enabled, the vertices are stored relative to a double precision origin close to the rubberband
+     * and the rubberband transforms them to the screen itself based on mapSettings. This avoids jitter
+     * with large map coordinates, the item must then not be placed under a MapTransform.
+     * Default is FALSE.
+     */
+    Q_PROPERTY( bool localOrigin READ localOrigin WRITE setLocalOrigin NOTIFY localOriginChanged )
+
   public:
     explicit Rubberband( QQuickItem *parent = nullptr );
 
@@ -75,6 +87,11 @@ class Rubberband : public QQuickItem
     //! \copydoc widthCurrentPoint
     void setWidthCurrentPoint( qreal width );
 
+    //! \copydoc localOrigin
+    bool localOrigin() const;
+    //! \copydoc localOrigin
+    void setLocalOrigin( bool localOrigin );
+
   signals:
     void modelChanged();
     void vertexModelChanged();
@@ -87,10 +104,15 @@ class Rubberband : public QQuickItem
     void colorCurrentPointChanged();
     //! \copydoc widthCurrentPoint
     void widthCurrentPointChanged();
+    //! \copydoc localOrigin
+    void localOriginChanged();
 
 
   private slots:
     void markDirty();
+    void onVertexChanged( int index );
+    void onVerticesChanged( int index );
+    void onVisibleExtentChanged();
 
   private:
     QSGNode *updatePaintNode( QSGNode *n, QQuickItem::UpdatePaintNodeData * );
@@ -98,11 +120,21 @@ class Rubberband : public QQuickItem
     RubberbandModel *mRubberbandModel = nullptr;
     VertexModel *mVertexModel = nullptr;
     QgsQuickMapSettings *mMapSettings = nullptr;
+    //! The nodes need to be recreated
     bool mDirty = false;
+    //! First vertex index which changed since the last update of the nodes
+    int mDirtyFrom = std::numeric_limits<int>::max();
+    //! First vertex index without the current point which changed since the last update of the nodes
+    int mDirtyFromSkipCurrent = std::numeric_limits<int>::max();
+    //! Current coordinate index of the last update of the nodes
+    int mCurrentCoordinateIndex = -1;
     QColor mColor = QColor( 192, 57, 43, 200 );
     qreal mWidth = 1.8;
     QColor mColorCurrentPoint = QColor( 192, 57, 43, 150 );
     qreal mWidthCurrentPoint = 1.2;
+    bool mLocalOrigin = false;
+    //! Origin of the vertices of the nodes if localOrigin is enabled
+    QgsPointXY mOrigin;
 };
 
 
@@ -14,10 +14,11 @@
  *                                                                         *
  ***************************************************************************/
 #include "rubberbandmodel.h"
+#include "coordinatetransformcache.h"
+#include "geometryutils.h"
 #include "snappingutils.h"
 
 #include <qgsvectorlayer.h>
-#include <qgsproject.h>
 #include <qgslogger.h>
 
 RubberbandModel::RubberbandModel( QObject *parent )
@@ -60,17 +61,21 @@ QVector<QgsPoint> RubberbandModel::flatVertices( bool skipCurrentPoint ) const
 QgsPointSequence RubberbandModel::pointSequence( const QgsCoordinateReferenceSystem &crs, QgsWkbTypes::Type wkbType, bool closeLine ) const
 {
   QgsPointSequence sequence;
-  QgsCoordinateTransform ct( mCrs, crs, QgsProject::instance()->transformContext() );
+  sequence.reserve( mPointList.size() + 1 );
 
-  for ( const QgsPoint &pt : mPointList )
+  //crs transformation of XY
+  QVector<double> x;
+  QVector<double> y;
+  coordinateArrays( x, y, crs );
+
+  for ( int i = 0; i < mPointList.size(); ++i )
   {
-    //crs transformation of XY
-    QgsPointXY p1 = ct.transform( pt.x(), pt.y() );
+    const QgsPoint &pt = mPointList.at( i );
 
     //get point containing ZM if existing
     QgsPoint p2 = SnappingUtils::newPoint( pt, wkbType );
-    p2.setX( p1.x() );
-    p2.setY( p1.y() );
+    p2.setX( x.at( i ) );
+    p2.setY( y.at( i ) );
 
     //overwrite z and m values if already existent in the point
     if ( QgsWkbTypes::hasM( pt.wkbType() ) && QgsWkbTypes::hasM( wkbType ) )
@@ -95,16 +100,36 @@ QgsPointSequence RubberbandModel::pointSequence( const QgsCoordinateReferenceSys
 
 QVector<QgsPointXY> RubberbandModel::flatPointSequence( const QgsCoordinateReferenceSystem &crs ) const
 {
+  QVector<double> x;
+  QVector<double> y;
+  coordinateArrays( x, y, crs );
+
   QVector<QgsPointXY> sequence;
+  sequence.reserve( x.size() );
+  for ( int i = 0; i < x.size(); ++i )
+  {
+    sequence.append( QgsPointXY( x.at( i ), y.at( i ) ) );
+  }
+
+  return sequence;
+}
 
-  QgsCoordinateTransform ct( mCrs, crs, QgsProject::instance()->transformContext() );
+void RubberbandModel::coordinateArrays( QVector<double> &x, QVector<double> &y, const QgsCoordinateReferenceSystem &crs ) const
+{
+  const int count = mPointList.size();
+  x.resize( count );
+  y.resize( count );
 
-  for ( const QgsPoint &pt : mPointList )
+  double *xData = x.data();
+  double *yData = y.data();
+  for ( int i = 0; i < count; ++i )
   {
-    sequence.append( ct.transform( pt.x(), pt.y() ) );
+    xData[i] = mPointList.at( i ).x();
+    yData[i] = mPointList.at( i ).y();
   }
 
-  return sequence;
+  QVector<double> z;
+  GeometryUtils::transformCoordinates( CoordinateTransformCache::instance()->transform( mCrs, crs ), x, y, z );
 }
 
 void RubberbandModel::setVertex( int index, QgsPoint coordinate )
@@ -136,7 +161,12 @@ void RubberbandModel::removeVertices( int index, int count )
   emit verticesRemoved( index, count );
   emit vertexCountChanged();
 
-  if ( mCurrentCoordinateIndex >= mPointList.size() )
+  // Vertices removed before the current one shift it
+  if ( index + count <= mCurrentCoordinateIndex )
+  {
+    setCurrentCoordinateIndex( mCurrentCoordinateIndex - count );
+  }
+  else if ( mCurrentCoordinateIndex >= mPointList.size() )
   {
     setCurrentCoordinateIndex( mPointList.size() - 1 );
     emit currentCoordinateChanged();
@@ -160,7 +190,7 @@ void RubberbandModel::setCurrentCoordinateIndex( int currentCoordinateIndex )
 
 QgsPoint RubberbandModel::currentPoint( const QgsCoordinateReferenceSystem &crs, QgsWkbTypes::Type wkbType ) const
 {
-  QgsCoordinateTransform ct( mCrs, crs, QgsProject::instance()->transformContext() );
+  const QgsCoordinateTransform ct = CoordinateTransformCache::instance()->transform( mCrs, crs );
 
   QgsPoint currentPt = mPointList.at( mCurrentCoordinateIndex );
   double x = currentPt.x();
@@ -286,7 +316,7 @@ void RubberbandModel::setDataFromGeometry( QgsGeometry geometry, const QgsCoordi
   if ( geometry.type() != mGeometryType )
     return;
 
-  QgsCoordinateTransform ct( crs, mCrs, QgsProject::instance()->transformContext() );
+  const QgsCoordinateTransform ct = CoordinateTransformCache::instance()->transform( crs, mCrs );
   geometry.transform( ct );
 
   mPointList.clear();
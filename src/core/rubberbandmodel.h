@@ -72,6 +72,14 @@ class RubberbandModel : public QObject
 
     QVector<QgsPointXY> flatPointSequence( const QgsCoordinateReferenceSystem &crs = QgsCoordinateReferenceSystem() ) const;
 
+    /**
+     * Returns the x and y coordinates of all vertices reprojected to \a crs as separate arrays.
+     * All vertices are transformed with a single call.
+     *
+     * By default coordinates will be returned unprojected.
+     */
+    void coordinateArrays( QVector<double> &x, QVector<double> &y, const QgsCoordinateReferenceSystem &crs = QgsCoordinateReferenceSystem() ) const;
+
     void setVertex( int index, QgsPoint coordinate );
 
     void insertVertices( int index, int count );
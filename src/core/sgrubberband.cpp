@@ -13,18 +13,38 @@
  *                                                                         *
  ***************************************************************************/
 #include "sgrubberband.h"
-extern "C" {
-#include "tessellate.h"
+#include "qgssgtessellator.h"
+
+#include <algorithm>
+
+static QSGGeometryNode *createGeometryNode( QSGMaterial *material, unsigned int drawingMode )
+{
+  QSGGeometryNode *node = new QSGGeometryNode;
+  QSGGeometry *sgGeom = new QSGGeometry( QSGGeometry::defaultAttributes_Point2D(), 0, 0, QSGGeometry::UnsignedIntType );
+  // The vertices are updated in place whenever the rubberband changes
+  sgGeom->setVertexDataPattern( QSGGeometry::DynamicPattern );
+  sgGeom->setIndexDataPattern( QSGGeometry::DynamicPattern );
+  sgGeom->setDrawingMode( drawingMode );
+  node->setGeometry( sgGeom );
+  node->setMaterial( material );
+  node->setFlag( QSGNode::OwnsGeometry );
+  node->setFlag( QSGNode::OwnedByParent );
+  return node;
+}
+
+//! Returns the capacity to allocate for \a count vertices, leaving room to grow without reallocating on every update
+static int growCapacity( int count, int capacity )
+{
+  return std::max( { count, 2 * capacity, 16 } );
 }
 
-SGRubberband::SGRubberband( const QVector<QgsPoint> &points, QgsWkbTypes::GeometryType type, const QColor &color, qreal width )
+SGRubberband::SGRubberband( QgsWkbTypes::GeometryType type, const QColor &color, qreal width, const QgsPointXY &origin )
   : QSGNode()
+  , mType( type )
+  , mOrigin( origin )
 {
   mMaterial.setColor( color );
 
-  if ( points.isEmpty() )
-    return;
-
   switch ( type )
   {
     case QgsWkbTypes::PointGeometry:
@@ -33,14 +53,17 @@ SGRubberband::SGRubberband( const QVector<QgsPoint> &points, QgsWkbTypes::Geomet
 
     case QgsWkbTypes::LineGeometry:
     {
-      appendChildNode( createLineGeometry( points, width ) );
+      mLineNode = createGeometryNode( &mMaterial, GL_LINES );
+      appendChildNode( mLineNode );
       break;
     }
 
     case QgsWkbTypes::PolygonGeometry:
     {
-      appendChildNode( createLineGeometry( points, width ) );
-      appendChildNode( createPolygonGeometry( points ) );
+      mLineNode = createGeometryNode( &mMaterial, GL_LINES );
+      appendChildNode( mLineNode );
+      mPolygonNode = createGeometryNode( &mMaterial, GL_TRIANGLES );
+      appendChildNode( mPolygonNode );
       break;
     }
 
@@ -48,68 +71,109 @@ SGRubberband::SGRubberband( const QVector<QgsPoint> &points, QgsWkbTypes::Geomet
     case QgsWkbTypes::NullGeometry:
       break;
   }
+
+  if ( mLineNode )
+    mLineNode->geometry()->setLineWidth( static_cast<float>( width ) );
 }
 
-QSGGeometryNode *SGRubberband::createLineGeometry( const QVector<QgsPoint> &points, qreal width )
+void SGRubberband::setVertices( const QVector<QgsPoint> &points, int from, int skipIndex )
 {
-  QSGGeometryNode *node = new QSGGeometryNode;
-  QSGGeometry *sgGeom = new QSGGeometry( QSGGeometry::defaultAttributes_Point2D(), points.count() );
+  if ( skipIndex >= points.size() )
+    skipIndex = -1;
+
+  const int count = skipIndex >= 0 ? points.size() - 1 : points.size();
+
+  if ( mLineNode )
+    updateLineGeometry( points, count, qBound( 0, from, std::min( count, mLineVertexCount ) ), skipIndex );
+  if ( mPolygonNode )
+    updatePolygonGeometry( points, count, from, skipIndex );
+}
+
+void SGRubberband::updateLineGeometry( const QVector<QgsPoint> &points, int count, int from, int skipIndex )
+{
+  QSGGeometry *sgGeom = mLineNode->geometry();
+  int previousCount = mLineVertexCount;
+  if ( count > sgGeom->vertexCount() )
+  {
+    // allocate() discards the previous vertices, every segment of the new capacity starts out degenerate
+    const int capacity = growCapacity( count, sgGeom->vertexCount() );
+    sgGeom->allocate( capacity, 2 * capacity );
+    std::fill_n( sgGeom->indexDataAsUInt(), sgGeom->indexCount(), 0u );
+    previousCount = 0;
+    from = 0;
+  }
+
   QSGGeometry::Point2D *vertices = sgGeom->vertexDataAsPoint2D();
+  for ( int i = from; i < count; ++i )
+  {
+    const QgsPoint &pt = points.at( skipIndex >= 0 && i >= skipIndex ? i + 1 : i );
+    vertices[i].set( static_cast<float>( pt.x() - mOrigin.x() ), static_cast<float>( pt.y() - mOrigin.y() ) );
+  }
 
-  int i = 0;
-  for ( const QgsPoint &pt : points )
+  // Segment i joins the vertices i and i + 1, unused segments point twice to the first vertex and draw nothing
+  if ( count != previousCount )
   {
-    vertices[i++].set( static_cast<float>( pt.x() ), static_cast<float>( pt.y() ) );
+    quint32 *indices = sgGeom->indexDataAsUInt();
+    for ( int i = std::max( previousCount - 1, 0 ); i < count - 1; ++i )
+    {
+      indices[2 * i] = static_cast<quint32>( i );
+      indices[2 * i + 1] = static_cast<quint32>( i + 1 );
+    }
+    for ( int i = std::max( count - 1, 0 ); i < previousCount - 1; ++i )
+    {
+      indices[2 * i] = 0;
+      indices[2 * i + 1] = 0;
+    }
+    sgGeom->markIndexDataDirty();
   }
 
-  sgGeom->setLineWidth( static_cast<float>( width ) );
-  sgGeom->setDrawingMode( GL_LINE_STRIP );
-  node->setGeometry( sgGeom );
-  node->setMaterial( &mMaterial );
-  node->setFlag( QSGNode::OwnsGeometry );
-  node->setFlag( QSGNode::OwnedByParent );
-  return node;
+  mLineVertexCount = count;
+  sgGeom->markVertexDataDirty();
+  mLineNode->markDirty( QSGNode::DirtyGeometry );
 }
 
-QSGGeometryNode *SGRubberband::createPolygonGeometry( const QVector<QgsPoint> &points )
+void SGRubberband::updatePolygonGeometry( const QVector<QgsPoint> &points, int count, int from, int skipIndex )
 {
-  double *coordinates_out;
-  int *tris_out;
-  int nverts, ntris;
-
-  double *vertices_in = ( double * )malloc( points.size() * 2 * sizeof( double ) );
-  const double *contours_array[] = { vertices_in, vertices_in + points.size() * 2 };
-  int i = 0;
+  // The triangulation depends on the whole ring, it only needs to be redone if the ring changed
+  if ( count == mPolygonRingCount && from >= count )
+    return;
+  mPolygonRingCount = count;
 
-  for ( const QgsPoint &pt : points )
+  QVector<QgsPointXY> triangles;
+  if ( count >= 3 )
   {
-    vertices_in[i++] = pt.x();
-    vertices_in[i++] = pt.y();
+    QgsPolylineXY ring;
+    ring.reserve( count );
+    for ( int j = 0; j < points.size(); j++ )
+    {
+      if ( j != skipIndex )
+        ring << QgsPointXY( points.at( j ).x() - mOrigin.x(), points.at( j ).y() - mOrigin.y() );
+    }
+    triangles = QgsSGTessellator::tessellate( QgsPolygonXY() << ring );
   }
 
-  tessellate( &coordinates_out, &nverts,
-              &tris_out, &ntris,
-              contours_array, contours_array + 2 );
-
-  QSGGeometryNode *node = new QSGGeometryNode;
-  QSGGeometry *sgGeom = new QSGGeometry( QSGGeometry::defaultAttributes_Point2D(), ntris * 3 );
+  QSGGeometry *sgGeom = mPolygonNode->geometry();
+  int previousCount = mPolygonVertexCount;
+  if ( triangles.size() > sgGeom->vertexCount() )
+  {
+    // allocate() leaves the new capacity uninitialized, it has to be cleared as a whole
+    sgGeom->allocate( growCapacity( triangles.size(), sgGeom->vertexCount() ) );
+    previousCount = sgGeom->vertexCount();
+  }
 
   QSGGeometry::Point2D *vertices = sgGeom->vertexDataAsPoint2D();
-
-  for ( int j = 0; j < ntris * 3; j++ )
+  for ( int j = 0; j < triangles.size(); j++ )
   {
-    vertices[j].x = coordinates_out[tris_out[j] * 2];
-    vertices[j].y = coordinates_out[tris_out[j] * 2 + 1];
+    vertices[j].set( static_cast<float>( triangles.at( j ).x() ), static_cast<float>( triangles.at( j ).y() ) );
   }
 
-  free( vertices_in );
-  free( coordinates_out );
-  free( tris_out );
+  // Triangles no longer in use collapse to a point and draw nothing
+  for ( int j = triangles.size(); j < previousCount; j++ )
+  {
+    vertices[j].set( 0, 0 );
+  }
 
-  sgGeom->setDrawingMode( GL_TRIANGLES );
-  node->setGeometry( sgGeom );
-  node->setMaterial( &mMaterial );
-  node->setFlag( QSGNode::OwnsGeometry );
-  node->setFlag( QSGNode::OwnedByParent );
-  return node;
+  mPolygonVertexCount = triangles.size();
+  sgGeom->markVertexDataDirty();
+  mPolygonNode->markDirty( QSGNode::DirtyGeometry );
 }
@@ -17,29 +17,57 @@
 
 #include <QtQuick/QSGNode>
 #include <QtQuick/QSGFlatColorMaterial>
+#include <QtQuick/QSGGeometryNode>
 
 #include <qgspoint.h>
+#include <qgspointxy.h>
 #include <qgswkbtypes.h>
 
 
-class RubberbandModel;
-
 /**
  * This is used to render a rubberband on the scene graph.
  *
+ * The geometry nodes are kept for the lifetime of the rubberband and updated in place
+ * with setVertices(), only the vertices from a given index on are converted again.
+ * The geometries are allocated with spare capacity, the unused part is degenerate and
+ * draws nothing, so appending vertices does not reallocate them on every update.
+ *
  * This cannot be considered stable API.
  */
 
 class SGRubberband : public QSGNode
 {
   public:
-    SGRubberband( const QVector<QgsPoint> &points, QgsWkbTypes::GeometryType type, const QColor &color, qreal width );
+    /**
+     * Creates a rubberband of the given \a type.
+     * The vertices are stored relative to \a origin, which should be close to the rubberband to keep float precision.
+     */
+    SGRubberband( QgsWkbTypes::GeometryType type, const QColor &color, qreal width, const QgsPointXY &origin = QgsPointXY( 0, 0 ) );
+
+    QgsWkbTypes::GeometryType type() const { return mType; }
+
+    /**
+     * Updates the rubberband to the given \a points.
+     * Only the vertices from \a from on have changed since the last update, earlier ones are kept.
+     * If \a skipIndex is not -1, the point at this index of \a points is not part of the rubberband.
+     */
+    void setVertices( const QVector<QgsPoint> &points, int from = 0, int skipIndex = -1 );
 
   private:
-    QSGGeometryNode *createLineGeometry( const QVector<QgsPoint> &points, qreal width );
-    QSGGeometryNode *createPolygonGeometry( const QVector<QgsPoint> &points );
+    void updateLineGeometry( const QVector<QgsPoint> &points, int count, int from, int skipIndex );
+    void updatePolygonGeometry( const QVector<QgsPoint> &points, int count, int from, int skipIndex );
 
+    QgsWkbTypes::GeometryType mType;
+    QgsPointXY mOrigin;
     QSGFlatColorMaterial mMaterial;
+    QSGGeometryNode *mLineNode = nullptr;
+    QSGGeometryNode *mPolygonNode = nullptr;
+    //! Number of vertices in use in the line geometry, the remaining capacity is degenerate
+    int mLineVertexCount = 0;
+    //! Number of vertices in use in the polygon geometry, the remaining capacity is degenerate
+    int mPolygonVertexCount = 0;
+    //! Number of vertices of the ring the polygon geometry was tessellated from
+    int mPolygonRingCount = -1;
 };
 
 #endif // QGSSGRUBBERBAND_H
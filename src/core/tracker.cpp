@@ -17,8 +17,56 @@
 
 #include "tracker.h"
 
+#include "coordinatetransformcache.h"
+#include "geometryutils.h"
 #include "rubberbandmodel.h"
+#include "snappingutils.h"
 #include "qgsproject.h"
+#include "qgslinestring.h"
+#include "qgsmessagelog.h"
+#include "qgspolygon.h"
+
+/**
+ * Appends \a vertices to the last line or to the exterior ring of the last polygon of \a geometry.
+ */
+static bool appendVertices( QgsGeometry &geometry, const QgsPointSequence &vertices )
+{
+  QgsAbstractGeometry *part = geometry.get();
+  if ( QgsGeometryCollection *collection = qgsgeometry_cast<QgsGeometryCollection *>( part ) )
+    part = collection->numGeometries() > 0 ? collection->geometryN( collection->numGeometries() - 1 ) : nullptr;
+
+  if ( QgsLineString *line = qgsgeometry_cast<QgsLineString *>( part ) )
+  {
+    for ( const QgsPoint &vertex : vertices )
+    {
+      if ( line->isEmpty() || line->endPoint() != vertex )
+        line->addVertex( vertex );
+    }
+    return true;
+  }
+
+  if ( QgsPolygon *polygon = qgsgeometry_cast<QgsPolygon *>( part ) )
+  {
+    QgsPointSequence ring;
+    if ( const QgsLineString *exteriorRing = qgsgeometry_cast<const QgsLineString *>( polygon->exteriorRing() ) )
+      exteriorRing->points( ring );
+
+    // The new vertices go before the closing one
+    if ( ring.size() > 1 )
+      ring.removeLast();
+    for ( const QgsPoint &vertex : vertices )
+    {
+      if ( ring.isEmpty() || ring.last() != vertex )
+        ring << vertex;
+    }
+    ring << ring.first();
+
+    polygon->setExteriorRing( new QgsLineString( ring ) );
+    return true;
+  }
+
+  return false;
+}
 
 Tracker::Tracker( QgsVectorLayer *layer, bool visible )
   : mLayer( layer ),
@@ -78,6 +126,30 @@ void Tracker::setMinimumDistance( const int minimumDistance )
   mMinimumDistance = minimumDistance;
 }
 
+double Tracker::simplificationTolerance() const
+{
+  return mSimplificationTolerance;
+}
+
+void Tracker::setSimplificationTolerance( const double simplificationTolerance )
+{
+  mSimplificationTolerance = simplificationTolerance;
+}
+
+void Tracker::setFeature( const QgsFeature &feature )
+{
+  // The feature is created with the vertices recorded so far
+  fixFloatingVertex();
+  mPendingVertices.clear();
+
+  mFeature = feature;
+}
+
+double Tracker::length() const
+{
+  return mLength;
+}
+
 void Tracker::trackPosition()
 {
   if ( std::isnan( model()->currentCoordinate().x() ) || std::isnan( model()->currentCoordinate().y() ) )
@@ -85,29 +157,148 @@ void Tracker::trackPosition()
     return;
   }
 
-  model()->addVertex();
+  const QgsPointXY vertex( model()->currentPoint( mMeasurementCrs ) );
+  const QgsPoint coordinate = model()->currentCoordinate();
   mTimeIntervalFulfilled = false;
   mMinimumDistanceFulfilled = false;
+
+  if ( mHasLastVertex )
+    mLength += mDistanceArea.measureLine( mLastVertex, vertex );
+
+  if ( mHasFloatingVertex && floatingVertexRedundant( vertex ) )
+  {
+    // The floating vertex follows the track instead of adding a new one
+    mSimplificationWindow << vertex;
+    mFloatingVertex = coordinate;
+    model()->setVertex( model()->currentCoordinateIndex() - 1, coordinate );
+    mLastVertex = vertex;
+    return;
+  }
+
+  fixFloatingVertex();
+
+  if ( mSimplificationTolerance > 0 && mHasLastVertex )
+  {
+    mSimplificationWindow << vertex;
+    mFloatingVertex = coordinate;
+    mHasFloatingVertex = true;
+  }
+  else
+  {
+    mSimplificationAnchor = vertex;
+    mPendingVertices << coordinate;
+  }
+
+  mLastVertex = vertex;
+  mHasLastVertex = true;
+
+  model()->addVertex();
+
+  if ( mPendingVertices.size() >= PERSIST_BATCH_SIZE )
+    persistVertices();
 }
 
-void Tracker::positionReceived()
+bool Tracker::floatingVertexRedundant( const QgsPointXY &position ) const
+{
+  if ( mSimplificationWindow.size() >= SIMPLIFICATION_WINDOW_SIZE )
+    return false;
+
+  const double sqrTolerance = mSimplificationToleranceMapUnits * mSimplificationToleranceMapUnits;
+  QgsPointXY minDistPoint;
+  for ( const QgsPointXY &point : mSimplificationWindow )
+  {
+    if ( point.sqrDistToSegment( mSimplificationAnchor.x(), mSimplificationAnchor.y(), position.x(), position.y(), minDistPoint ) > sqrTolerance )
+      return false;
+  }
+
+  return true;
+}
+
+void Tracker::fixFloatingVertex()
 {
+  if ( !mHasFloatingVertex )
+    return;
+
+  mPendingVertices << mFloatingVertex;
+  mSimplificationAnchor = mSimplificationWindow.last();
+  mSimplificationWindow.clear();
+  mHasFloatingVertex = false;
+}
+
+bool Tracker::persistVertices()
+{
+  if ( mPendingVertices.isEmpty() || !mLayer || !mRubberbandModel || FID_IS_NULL( mFeature.id() ) )
+    return false;
+
+  QgsFeature feature;
+  if ( !mLayer->getFeatures( QgsFeatureRequest( mFeature.id() ).setNoAttributes() ).nextFeature( feature ) || feature.geometry().isNull() )
+    return false;
+
+  QVector<double> x;
+  QVector<double> y;
+  QVector<double> z;
+  x.reserve( mPendingVertices.size() );
+  y.reserve( mPendingVertices.size() );
+  for ( const QgsPoint &vertex : qgis::as_const( mPendingVertices ) )
+  {
+    x << vertex.x();
+    y << vertex.y();
+  }
 
-  QVector<QgsPointXY> points = mRubberbandModel->flatPointSequence( QgsProject::instance()->crs() );
+  try
+  {
+    GeometryUtils::transformCoordinates( CoordinateTransformCache::instance()->transform( mRubberbandModel->crs(), mLayer->crs() ), x, y, z );
+  }
+  catch ( const QgsCsException &e )
+  {
+    QgsMessageLog::logMessage( tr( "Cannot transform the track to the layer \"%1\": %2" ).arg( mLayer->name(), e.what() ), QStringLiteral( "QField" ), Qgis::Warning );
+    return false;
+  }
 
-  auto pointIt = points.constEnd() - 1;
+  QgsPointSequence vertices;
+  vertices.reserve( mPendingVertices.size() );
+  for ( int i = 0; i < mPendingVertices.size(); ++i )
+  {
+    QgsPoint vertex = SnappingUtils::newPoint( mPendingVertices.at( i ), mLayer->wkbType() );
+    vertex.setX( x.at( i ) );
+    vertex.setY( y.at( i ) );
+    vertices << vertex;
+  }
 
-  QVector<QgsPointXY> flatPoints;
+  QgsGeometry geometry = feature.geometry();
+  if ( !appendVertices( geometry, vertices ) )
+    return false;
 
-  flatPoints << *pointIt;
-  pointIt--;
-  flatPoints << *pointIt;
+  // One transaction per batch, an edit session of the user is left open
+  const bool wasEditable = mLayer->isEditable();
+  if ( !wasEditable && !mLayer->startEditing() )
+    return false;
 
-  QgsDistanceArea distanceArea;
-  distanceArea.setEllipsoid( QgsProject::instance()->ellipsoid() );
-  distanceArea.setSourceCrs( QgsProject::instance()->crs(), QgsProject::instance()->transformContext() );
+  mLayer->changeGeometry( mFeature.id(), geometry );
 
-  if ( distanceArea.measureLine( flatPoints ) > mMinimumDistance )
+  if ( !wasEditable && !mLayer->commitChanges() )
+  {
+    QgsMessageLog::logMessage( tr( "Cannot store the track on layer \"%1\": %2" ).arg( mLayer->name(), mLayer->commitErrors().join( QStringLiteral( "\n" ) ) ), QStringLiteral( "QField" ), Qgis::Warning );
+    mLayer->rollBack();
+    return false;
+  }
+
+  mPendingVertices.clear();
+
+  // Stored vertices are drawn by the layer, the rubberband keeps the end of the track and the current position
+  const int storedVertices = mRubberbandModel->vertexCount() - 1 - DISPLAY_WINDOW_SIZE;
+  if ( storedVertices > 0 )
+    mRubberbandModel->removeVertices( 0, storedVertices );
+
+  return true;
+}
+
+void Tracker::positionReceived()
+{
+  // Only the new position is transformed, whatever the length of the track
+  const QgsPointXY position( mRubberbandModel->currentPoint( mMeasurementCrs ) );
+
+  if ( !mHasLastVertex || mDistanceArea.measureLine( mLastVertex, position ) > mMinimumDistance )
   {
     mMinimumDistanceFulfilled = true;
     if ( !mConjunction || mTimeIntervalFulfilled )
@@ -134,6 +325,19 @@ void Tracker::start()
     connect( mRubberbandModel, &RubberbandModel::currentCoordinateChanged, this, &Tracker::positionReceived );
   }
 
+  mMeasurementCrs = QgsProject::instance()->crs();
+  mDistanceArea.setEllipsoid( QgsProject::instance()->ellipsoid() );
+  mDistanceArea.setSourceCrs( mMeasurementCrs, QgsProject::instance()->transformContext() );
+  mHasLastVertex = false;
+  mLength = 0;
+
+  // The tolerance is given in the units of the measurements, i.e. meters on the ellipsoid
+  mSimplificationToleranceMapUnits = mSimplificationTolerance;
+  if ( mDistanceArea.willUseEllipsoid() )
+    mSimplificationToleranceMapUnits *= QgsUnitTypes::fromUnitToUnitFactor( QgsUnitTypes::DistanceMeters, mMeasurementCrs.mapUnits() );
+  mSimplificationWindow.clear();
+  mHasFloatingVertex = false;
+
   //set the start time
   setStartPositionTimestamp( QDateTime::currentDateTime() );
   model()->setMeasureValue(0);
@@ -144,6 +348,9 @@ void Tracker::start()
 
 void Tracker::stop()
 {
+  fixFloatingVertex();
+  persistVertices();
+
   if ( mTimeInterval > 0 )
   {
     mTimer.stop();
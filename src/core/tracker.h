@@ -19,8 +19,17 @@
 #include <QTimer>
 #include "qgsvectorlayer.h"
 
+#include <qgsdistancearea.h>
+
 class RubberbandModel;
 
+/**
+ * Records the positions of a tracking session in a rubberband model.
+ *
+ * Once the feature of the session exists, the recorded vertices are appended to its geometry
+ * in batches and the rubberband only keeps the most recent ones to display them. The memory
+ * use does not grow with the duration of the session and a crash loses at most one batch.
+ */
 class Tracker : public QObject
 {
     Q_OBJECT
@@ -43,6 +52,14 @@ class Tracker : public QObject
     //! the minimum distance between setting trackpoints
     void setMinimumDistance( const int minimumDistance );
 
+    /**
+     * the maximum distance between a recorded position and the stored track, 0 to keep every position.
+     * Positions along a straight path move the last vertex instead of adding a new one.
+     */
+    double simplificationTolerance() const;
+    //! \copydoc simplificationTolerance
+    void setSimplificationTolerance( const double simplificationTolerance );
+
     //! if both, the minimum distance and the time interval, needs to be fulfilled before setting trackpoints
     bool conjunction() const;
     //! if both, the minimum distance and the time interval, needs to be fulfilled before setting trackpoints
@@ -59,16 +76,33 @@ class Tracker : public QObject
     void setLayer( QgsVectorLayer *layer ) { mLayer = layer; }
     //! the created feature
     QgsFeature feature() const { return mFeature; }
-    //! the created feature
-    void setFeature( const QgsFeature& feature ) { mFeature = feature; }
+    //! the created feature, vertices recorded from now on are appended to its geometry
+    void setFeature( const QgsFeature &feature );
     //! if the layer (and the rubberband ) is visible
     bool visible() const { return mVisible; }
     //! if the layer (and the rubberband ) is visible
     void setVisible( const bool visible ) { mVisible = visible; }
 
+    //! the length of the track up to the last recorded position, in meters on the project ellipsoid
+    double length() const;
+
     void start();
     void stop();
 
+    /**
+     * Appends the vertices recorded since the last write to the geometry of the feature in the layer
+     * and drops the stored vertices from the rubberband, except for the most recent ones.
+     * Returns false if nothing could be written.
+     */
+    bool persistVertices();
+
+    //! Number of recorded vertices written to the layer at once
+    static const int PERSIST_BATCH_SIZE = 20;
+    //! Number of stored vertices kept in the rubberband to display the end of the track
+    static const int DISPLAY_WINDOW_SIZE = 200;
+    //! Maximum number of positions a vertex can stand for when simplifying the track
+    static const int SIMPLIFICATION_WINDOW_SIZE = 100;
+
   signals:
     void startPositionTimestampChanged();
 
@@ -82,6 +116,7 @@ class Tracker : public QObject
     QTimer mTimer;
     int mTimeInterval = 0;
     int mMinimumDistance = 0;
+    double mSimplificationTolerance = 0;
     bool mConjunction = true;
     bool mTimeIntervalFulfilled = false;
     bool mMinimumDistanceFulfilled = false;
@@ -93,7 +128,33 @@ class Tracker : public QObject
 
     QDateTime mStartPositionTimestamp;
 
+    //! Running state, every position is measured against the last recorded vertex only
+    QgsDistanceArea mDistanceArea;
+    QgsCoordinateReferenceSystem mMeasurementCrs;
+    QgsPointXY mLastVertex;
+    bool mHasLastVertex = false;
+    double mLength = 0;
+
+    //! Vertices recorded since the last write, in the CRS of the rubberband
+    QVector<QgsPoint> mPendingVertices;
+
+    /**
+     * Sliding window of the simplification, in the measurement CRS: the last fixed vertex and the positions
+     * recorded since. The last of them is the floating vertex, moved along as long as the window stays
+     * within the tolerance of the segment from the anchor.
+     */
+    QgsPointXY mSimplificationAnchor;
+    QVector<QgsPointXY> mSimplificationWindow;
+    double mSimplificationToleranceMapUnits = 0;
+    //! The floating vertex in the CRS of the rubberband, not written before it is fixed
+    QgsPoint mFloatingVertex;
+    bool mHasFloatingVertex = false;
+
     void trackPosition();
+    //! Whether the floating vertex can be dropped for a segment from the anchor to \a position
+    bool floatingVertexRedundant( const QgsPointXY &position ) const;
+    //! Keeps the floating vertex in the track
+    void fixFloatingVertex();
 
 };
 
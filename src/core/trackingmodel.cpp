@@ -34,6 +34,7 @@ QHash<int, QByteArray> TrackingModel::roleNames() const
   roles[VectorLayer] = "vectorLayer";
   roles[TimeInterval] = "timeInterval";
   roles[MinimumDistance] = "minimumDistance";
+  roles[SimplificationTolerance] = "simplificationTolerance";
   roles[Conjunction] = "conjunction";
   roles[Feature] = "feature";
   roles[RubberModel] = "rubberModel";
@@ -98,6 +99,9 @@ bool TrackingModel::setData( const QModelIndex &index, const QVariant &value, in
     case MinimumDistance:
       currentTracker->setMinimumDistance( value.toInt() );
       break;
+    case SimplificationTolerance:
+      currentTracker->setSimplificationTolerance( value.toDouble() );
+      break;
     case Conjunction:
       currentTracker->setConjunction( value.toBool() );
       break;
@@ -39,6 +39,7 @@ class TrackingModel : public QAbstractItemModel
       RubberModel,        //! the rubberbandmodel used in the current tracking session
       TimeInterval,       //! the (minimum) time interval between setting trackpoints
       MinimumDistance,    //! the minimum distance between setting trackpoints
+      SimplificationTolerance, //! the maximum distance between the recorded positions and the simplified track
       Conjunction,        //! if both, the minimum distance and the time interval, needs to be fulfilled before setting trackpoints
       Visible,            //! if the layer and so the tracking components like rubberband is visible
       Feature,            //! the feature in the current tracking session
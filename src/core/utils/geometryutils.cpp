@@ -16,6 +16,7 @@
 
 #include "geometryutils.h"
 
+#include <qgscoordinatetransform.h>
 #include <qgslinestring.h>
 #include <qgspolygon.h>
 #include <qgsvectorlayer.h>
@@ -30,10 +31,17 @@ GeometryUtils::GeometryUtils( QObject *parent ) : QObject( parent )
 
 QgsGeometry GeometryUtils::polygonFromRubberband( RubberbandModel *rubberBandModel, const QgsCoordinateReferenceSystem &crs )
 {
-  QgsPointSequence ring = rubberBandModel->pointSequence( crs, QgsWkbTypes::Point, true );
-  QgsLineString ext( ring );
+  QVector<double> x;
+  QVector<double> y;
+  rubberBandModel->coordinateArrays( x, y, crs );
+  if ( x.size() > 1 )
+  {
+    x << x.at( 0 );
+    y << y.at( 0 );
+  }
+
   std::unique_ptr< QgsPolygon > polygon = qgis::make_unique< QgsPolygon >( );
-  polygon->setExteriorRing( ext.clone() );
+  polygon->setExteriorRing( new QgsLineString( x, y ) );
   QgsGeometry g( std::move( polygon ) );
   return g;
 }
@@ -60,3 +68,18 @@ QgsGeometry::OperationResult GeometryUtils::splitFeatureFromRubberband( QgsVecto
   return layer->splitFeatures( line, true );
 }
 
+void GeometryUtils::transformCoordinates( const QgsCoordinateTransform &transform, QVector<double> &x, QVector<double> &y, QVector<double> &z )
+{
+  Q_ASSERT( x.size() == y.size() );
+  Q_ASSERT( z.isEmpty() || z.size() == x.size() );
+
+  if ( x.isEmpty() || !transform.isValid() || transform.isShortCircuited() )
+    return;
+
+  // PROJ transforms z along, a 2D transformation works on a scratch array
+  QVector<double> zeros;
+  if ( z.isEmpty() )
+    zeros.fill( 0, x.size() );
+
+  transform.transformCoords( x.size(), x.data(), y.data(), z.isEmpty() ? zeros.data() : z.data() );
+}
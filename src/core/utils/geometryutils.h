@@ -21,6 +21,7 @@
 #include <qgsgeometry.h>
 #include <qgsfeature.h>
 
+class QgsCoordinateTransform;
 class QgsVectorLayer;
 class RubberbandModel;
 
@@ -40,6 +41,14 @@ class GeometryUtils : public QObject
     //! This will perform a split using the line in the rubberband model. It works with the layer selection if some features are selected.
     static Q_INVOKABLE QgsGeometry::OperationResult splitFeatureFromRubberband( QgsVectorLayer *layer, RubberbandModel *rubberBandModel );
 
+    /**
+     * Transforms coordinates stored as separate \a x, \a y and \a z arrays in place with a single call
+     * instead of one call per point. The arrays must have the same size, \a z may be left empty for a
+     * 2D transformation.
+     * \throws QgsCsException if the transformation fails
+     */
+    static void transformCoordinates( const QgsCoordinateTransform &transform, QVector<double> &x, QVector<double> &y, QVector<double> &z );
+
 };
 
 #endif // GEOMETRYUTILS_H
@@ -23,6 +23,7 @@
 #include <qgsmessagelog.h>
 
 #include "vertexmodel.h"
+#include "coordinatetransformcache.h"
 #include "qgsquickmapsettings.h"
 
 
@@ -95,7 +96,7 @@ void VertexModel::refreshGeometry()
   {
     try
     {
-      mTransform = QgsCoordinateTransform( mCrs, mMapSettings->destinationCrs(), mMapSettings->transformContext() );
+      mTransform = CoordinateTransformCache::instance()->transform( mCrs, mMapSettings->destinationCrs(), mMapSettings->transformContext() );
       mTransform.setAllowFallbackTransforms( true );
       if ( mTransform.isValid() )
         geom.transform( mTransform );
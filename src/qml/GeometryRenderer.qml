@@ -39,10 +39,7 @@ Item {
     LinePolygonHighlight {
       id: linePolygonHighlightItem
       mapSettings: geometryRenderer.mapSettings
-
-      transform: MapTransform {
-        mapSettings: geometryRenderer.mapSettings
-      }
+      localOrigin: true
 
       geometry: geometryRenderer.geometryWrapper
       color: geometryRenderer.color
@@ -20,12 +20,19 @@ import QtQuick.Controls 2.12
 import QtQml 2.2
 
 import org.qgis 1.0
+import Theme 1.0
 
 Item {
   id: mapArea
   property alias mapSettings: mapCanvasWrapper.mapSettings
   property alias isRendering: mapCanvasWrapper.isRendering
   property alias incrementalRendering: mapCanvasWrapper.incrementalRendering
+  property alias tiledRendering: mapCanvasWrapper.tiledRendering
+  property alias previewRendering: mapCanvasWrapper.previewRendering
+  property alias prerenderMargin: mapCanvasWrapper.prerenderMargin
+  property alias movementDirection: mapCanvasWrapper.movementDirection
+  property alias renderStatistics: mapCanvasWrapper.renderStatistics
+  property bool showRenderStatistics: false
 
   property bool mouseAsTouchScreen: qfieldSettings.mouseAsTouchScreen
   property bool freehandDigitizing: false
@@ -257,4 +264,76 @@ Item {
     }
 
     // TODO add WheelHandler once we can expect Qt 5.14 on all platforms
+
+  Rectangle {
+    id: renderStatisticsOverlay
+    visible: showRenderStatistics
+    anchors.top: parent.top
+    anchors.right: parent.right
+    anchors.margins: 8
+    width: Math.min( 280, mapArea.width - 16 )
+    height: renderStatisticsColumn.height + 16
+    radius: 4
+    color: Theme.darkGraySemiOpaque
+
+    Column {
+      id: renderStatisticsColumn
+      x: 8
+      y: 8
+      width: parent.width - 16
+      spacing: 2
+
+      Text {
+        width: parent.width
+        color: Theme.light
+        font: Theme.tipFont
+        text: qsTr( "Total: %1 ms, labeling: %2 ms" ).arg( renderStatistics.totalTime ).arg( renderStatistics.labelingTime )
+      }
+
+      Text {
+        width: parent.width
+        color: Theme.light
+        font: Theme.tipFont
+        text: qsTr( "First update: %1, texture upload: %2 ms" )
+                .arg( renderStatistics.firstUpdateTime >= 0 ? renderStatistics.firstUpdateTime + ' ms' : '-' )
+                .arg( renderStatistics.textureUploadTime.toFixed( 1 ) )
+      }
+
+      Text {
+        width: parent.width
+        color: Theme.light
+        font: Theme.tipFont
+        text: qsTr( "Cancelled jobs: %1, wasted: %2 ms" ).arg( renderStatistics.cancelledJobCount ).arg( renderStatistics.wastedTime )
+      }
+
+      Repeater {
+        model: renderStatistics.layerTimes
+
+        Text {
+          width: parent.width
+          color: Theme.light
+          font: Theme.tipFont
+          elide: Text.ElideMiddle
+          text: modelData.time + ' ms  ' + modelData.name
+        }
+      }
+
+      Text {
+        id: renderStatisticsDumpLink
+        width: parent.width
+        color: Theme.mainColor
+        font: Theme.tipFont
+        wrapMode: Text.WrapAnywhere
+        text: qsTr( "Save as CSV and JSON" )
+
+        MouseArea {
+          anchors.fill: parent
+          onClicked: {
+            var path = renderStatistics.dump()
+            renderStatisticsDumpLink.text = path !== '' ? qsTr( "Saved to %1" ).arg( path ) : qsTr( "Saving failed" )
+          }
+        }
+      }
+    }
+  }
 }
@@ -13,6 +13,9 @@ Page {
   property alias fullScreenIdentifyView: registry.fullScreenIdentifyView
   property alias locatorKeepScale: registry.locatorKeepScale
   property alias incrementalRendering: registry.incrementalRendering
+  property alias tiledRendering: registry.tiledRendering
+  property alias previewRendering: registry.previewRendering
+  property alias showRenderStatistics: registry.showRenderStatistics
   property alias numericalDigitizingInformation: registry.numericalDigitizingInformation
   property alias nativeCamera: registry.nativeCamera
   property alias autoSave: registry.autoSave
@@ -24,6 +27,9 @@ Page {
     property bool fullScreenIdentifyView
     property bool locatorKeepScale
     property bool incrementalRendering
+    property bool tiledRendering
+    property bool previewRendering: true
+    property bool showRenderStatistics
     property bool numericalDigitizingInformation
     property bool nativeCamera: true
     property bool autoSave
@@ -50,6 +56,21 @@ Page {
           description: qsTr( "When progressive rendering is enabled, the map will be drawn every 250 milliseconds while rendering." )
           settingAlias: "incrementalRendering"
       }
+      ListElement {
+          title: qsTr( "Tiled rendering" )
+          description: qsTr( "When tiled rendering is enabled, rendered map tiles are kept in memory and reused while panning, when zooming back to a previous scale and when the project is opened again. Labels may be cut at tile borders." )
+          settingAlias: "tiledRendering"
+      }
+      ListElement {
+          title: qsTr( "Preview while navigating" )
+          description: qsTr( "When enabled, a quick low resolution map is drawn while panning and zooming, so newly revealed areas do not stay blank until the gesture ends." )
+          settingAlias: "previewRendering"
+      }
+      ListElement {
+          title: qsTr( "Show rendering statistics" )
+          description: qsTr( "Overlays the map with the time spent rendering each layer, labeling and uploading the map image. The statistics can be saved as CSV and JSON files." )
+          settingAlias: "showRenderStatistics"
+      }
       ListElement {
           title: qsTr( "Show digitizing information" )
           description: qsTr( "When switched on, coordinate information, such as latitude and longitude, is overlayed onto the canvas while digitizing new features or using the measure tool." )
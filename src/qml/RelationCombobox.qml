@@ -11,6 +11,7 @@ Item {
   id: relationCombobox
 
   Component.onCompleted: {
+    comboBox._cachedCurrentValue = value
     comboBox.currentIndex = featureListModel.findKey(value)
     comboBox.visible = _relation !== undefined ? _relation.isValid : true
     addButton.visible = _relation !== undefined ? _relation.isValid : false
@@ -43,8 +44,10 @@ Item {
       textRole: 'display'
       model: featureListModel
 
-      onCurrentIndexChanged: {
-        var newValue = featureListModel.dataFromRowIndex(currentIndex, FeatureListModel.KeyFieldRole)
+      // Only user picks change the value, the index is otherwise set to follow it
+      onActivated: {
+        var newValue = featureListModel.dataFromRowIndex(index, FeatureListModel.KeyFieldRole)
+        _cachedCurrentValue = newValue
         valueChanged(newValue, false)
       }
 
@@ -54,6 +57,15 @@ Item {
         onModelReset: {
           comboBox.currentIndex = featureListModel.findKey(comboBox._cachedCurrentValue)
         }
+
+        onRowsInserted: {
+          comboBox.currentIndex = featureListModel.findKey(comboBox._cachedCurrentValue)
+        }
+
+        onIsLoadingChanged: {
+          if ( !featureListModel.isLoading )
+            comboBox.currentIndex = featureListModel.findKey(comboBox._cachedCurrentValue)
+        }
       }
 
       MouseArea {
@@ -140,12 +152,12 @@ Item {
     onFeatureSaved: {
       var referencedValue = embeddedPopup.attributeFormModel.attribute(relationCombobox._relation.resolveReferencedField(field.name))
       var index = featureListModel.findKey(referencedValue)
-      if ( ( featureListModel.addNull == true && index < 1 ) || index < 0 ) {
-        // model not yet reloaded - keep the value and set it onModelReset
-        comboBox._cachedCurrentValue = referencedValue
-      } else {
+      // model not yet reloaded - the cached value is selected once it is there
+      comboBox._cachedCurrentValue = referencedValue
+      if ( !( ( featureListModel.addNull == true && index < 1 ) || index < 0 ) ) {
         comboBox.currentIndex = index
       }
+      valueChanged(referencedValue, false)
     }
   }
 }
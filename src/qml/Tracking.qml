@@ -13,6 +13,7 @@ Item{
     id: tracking
 
     property var mainModel: model
+    property bool trackFeatureCreated: false
 
     Component.onCompleted: {
         featureModel.resetAttributes()
@@ -30,23 +31,17 @@ Item{
         crs: mapCanvas.mapSettings.destinationCrs
 
         onVertexCountChanged: {
-          if( ( geometryType === QgsWkbTypes.LineGeometry && vertexCount > 2 ) ||
-              ( geometryType === QgsWkbTypes.PolygonGeometry &&vertexCount > 3 ) )
+          // the feature is created once, from then on the tracker appends the vertices to it in batches
+          if( !trackFeatureCreated &&
+              ( ( geometryType === QgsWkbTypes.LineGeometry && vertexCount > 2 ) ||
+                ( geometryType === QgsWkbTypes.PolygonGeometry && vertexCount > 3 ) ) )
           {
               featureModel.applyGeometry()
 
-              if( ( geometryType === QgsWkbTypes.LineGeometry && vertexCount == 3 ) ||
-                  ( geometryType === QgsWkbTypes.PolygonGeometry && vertexCount == 4 ) )
-              {
-                  // indirect action, no need to check for success and display a toast, the log is enough
-                  featureModel.create()
-                  mainModel.feature = featureModel.feature
-              }
-              else
-              {
-                  // indirect action, no need to check for success and display a toast, the log is enough
-                  featureModel.save()
-              }
+              // indirect action, no need to check for success and display a toast, the log is enough
+              featureModel.create()
+              mainModel.feature = featureModel.feature
+              trackFeatureCreated = true
           }
         }
     }
@@ -57,6 +52,7 @@ Item{
         color: Qt.rgba(Math.random(),Math.random(),Math.random(),0.6);
 
         mapSettings: mapCanvas.mapSettings
+        localOrigin: true
 
         model: rubberbandModel
 
@@ -187,6 +183,7 @@ Item{
                     {
                         mainModel.timeInterval = timeIntervalText.text.length == 0 || !timeIntervalCheck.checked ? 0 : timeIntervalText.text
                         mainModel.minimumDistance = distanceText.text.length == 0 || !distanceCheck.checked ? 0 : distanceText.text
+                        mainModel.simplificationTolerance = simplificationText.text.length == 0 || !simplificationCheck.checked ? 0 : Number(simplificationText.text)
                         mainModel.conjunction = conjunction.checked
                         mainModel.rubberModel = rubberbandModel
 
@@ -289,6 +286,42 @@ Item{
                     }
                 }
 
+                CheckBox {
+                    id: simplificationCheck
+                    text: qsTr( 'Simplification tolerance (%1)' ).arg( UnitTypes.toAbbreviatedString( infoDistanceArea.lengthUnits ) )
+                    font: Theme.defaultFont
+
+                    Layout.fillWidth: true
+                    indicator.height: 16
+                    indicator.width: 16
+                    indicator.implicitHeight: 24
+                    indicator.implicitWidth: 24
+                }
+
+                TextField {
+                    id: simplificationText
+                    enabled: simplificationCheck.checked
+                    height: fontMetrics.height + 20
+                    topPadding: 10
+                    bottomPadding: 10
+                    Layout.fillWidth: true
+                    font: Theme.defaultFont
+                    text: '1'
+
+                    inputMethodHints: Qt.ImhFormattedNumbersOnly
+
+                    validator: DoubleValidator {
+                      bottom: 0
+                    }
+
+                    background: Rectangle {
+                    y: simplificationText.height - height - simplificationText.bottomPadding / 2
+                    implicitWidth: 120
+                    height: simplificationText.activeFocus ? 2: 1
+                    color: simplificationText.activeFocus ? "#4CAF50" : "#C8E6C9"
+                    }
+                }
+
                 Item {
                     // spacer item
                     height: 12
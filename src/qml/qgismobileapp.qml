@@ -265,6 +265,14 @@ ApplicationWindow {
 
       id: mapCanvasMap
       incrementalRendering: qfieldSettings.incrementalRendering
+      tiledRendering: qfieldSettings.tiledRendering
+      previewRendering: qfieldSettings.previewRendering
+      // While following the location, render ahead of the movement so recentering shows already rendered pixels
+      prerenderMargin: gpsButton.followActive ? 0.25 : 0
+      movementDirection: gpsButton.followActive && positionSource.position.directionValid && positionSource.position.speedValid && positionSource.position.speed > 0.5
+                         ? positionSource.position.direction
+                         : -1
+      showRenderStatistics: qfieldSettings.showRenderStatistics
       freehandDigitizing: freehandButton.freehandDigitizing && freehandHandler.active
 
       anchors.fill: parent
@@ -347,20 +355,17 @@ ApplicationWindow {
    * - Digitizing Rubberband
    **************************************************/
 
-    /* A transformation node for overlays in map coordinates */
+    /* Overlays in map coordinates, transformed to the screen by each item relative to its own origin */
     Item {
       anchors.fill: parent
 
-      transform: MapTransform {
-        mapSettings: mapCanvas.mapSettings
-      }
-
       /** A rubberband for ditizing **/
       Rubberband {
         id: digitizingRubberband
         width: 2
 
         mapSettings: mapCanvas.mapSettings
+        localOrigin: true
 
         model: RubberbandModel {
           frozen: false
@@ -381,6 +386,7 @@ ApplicationWindow {
         color: '#80000000'
 
         mapSettings: mapCanvas.mapSettings
+        localOrigin: true
 
         model: RubberbandModel {
           frozen: false
@@ -418,6 +424,7 @@ ApplicationWindow {
         color: '#80000000'
 
         mapSettings: mapCanvas.mapSettings
+        localOrigin: true
 
         model: RubberbandModel {
           frozen: false
@@ -480,11 +487,8 @@ ApplicationWindow {
         id: editingRubberband
         vertexModel: vertexModel
         mapSettings: mapCanvas.mapSettings
+        localOrigin: true
         width: 4
-
-        transform: MapTransform {
-          mapSettings: mapCanvas.mapSettings
-        }
       }
     }
 
@@ -506,7 +510,7 @@ ApplicationWindow {
       color: "yellow"
       focusedColor: "#ff7777"
       selectedColor: Theme.mainColor
-      width: 5
+      anchors.fill: parent
     }
   }
 
@@ -0,0 +1,130 @@
+/***************************************************************************
+                        test_coordinatetransformcache.cpp
+                        --------------------
+  begin                : Oct 2026
+  copyright            : (C) 2026 by QField contributors
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include <QtTest>
+#include <QtConcurrent>
+
+#include "qfield_testbase.h"
+
+#include "coordinatetransformcache.h"
+
+#include <qgsproject.h>
+
+#include <numeric>
+
+
+class TestCoordinateTransformCache: public QObject
+{
+    Q_OBJECT
+  private slots:
+    void initTestCase()
+    {
+      mLv95 = QgsCoordinateReferenceSystem( QStringLiteral( "EPSG:2056" ) );
+      mWgs84 = QgsCoordinateReferenceSystem( QStringLiteral( "EPSG:4326" ) );
+    }
+
+    void testCache()
+    {
+      CoordinateTransformCache cache;
+      const QgsCoordinateTransformContext context;
+
+      const QgsCoordinateTransform transform = cache.transform( mLv95, mWgs84, context );
+      QVERIFY( transform.isValid() );
+      QCOMPARE( cache.count(), 1 );
+
+      // The same pair of CRS is a lookup
+      const QgsCoordinateTransform cached = cache.transform( mLv95, mWgs84, context );
+      QCOMPARE( cache.count(), 1 );
+      QCOMPARE( cached.transform( QgsPointXY( 2600000, 1200000 ) ), transform.transform( QgsPointXY( 2600000, 1200000 ) ) );
+
+      // The reverse direction is another transform
+      const QgsCoordinateTransform reverse = cache.transform( mWgs84, mLv95, context );
+      QCOMPARE( cache.count(), 2 );
+      const QgsPointXY point = reverse.transform( transform.transform( QgsPointXY( 2600000, 1200000 ) ) );
+      QVERIFY( qgsDoubleNear( point.x(), 2600000, 0.001 ) );
+      QVERIFY( qgsDoubleNear( point.y(), 1200000, 0.001 ) );
+
+      // Another transform context gets its own transform, next to the one of the default context
+      QgsCoordinateTransformContext otherContext;
+      otherContext.addCoordinateOperation( mLv95, mWgs84, QStringLiteral( "+proj=noop" ) );
+      cache.transform( mLv95, mWgs84, otherContext );
+      QCOMPARE( cache.count(), 3 );
+      cache.transform( mLv95, mWgs84, context );
+      QCOMPARE( cache.count(), 3 );
+
+      cache.clear();
+      QCOMPARE( cache.count(), 0 );
+    }
+
+    void testProjectTransformContext()
+    {
+      CoordinateTransformCache *cache = CoordinateTransformCache::instance();
+      cache->transform( mLv95, mWgs84 );
+      QVERIFY( cache->count() > 0 );
+
+      // Transforms created with the former project transform context are dropped
+      QgsCoordinateTransformContext context;
+      context.addCoordinateOperation( mLv95, mWgs84, QStringLiteral( "+proj=noop" ) );
+      QgsProject::instance()->setTransformContext( context );
+      QCOMPARE( cache->count(), 0 );
+
+      QgsProject::instance()->setTransformContext( QgsCoordinateTransformContext() );
+    }
+
+    void testThreads()
+    {
+      CoordinateTransformCache cache;
+      const QgsCoordinateTransformContext context;
+
+      QVector<int> jobs( 64 );
+      std::iota( jobs.begin(), jobs.end(), 0 );
+      const QVector<QgsPointXY> points = QtConcurrent::blockingMapped<QVector<QgsPointXY>>( jobs, [this, &cache, &context]( int job )
+      {
+        return cache.transform( mLv95, mWgs84, context ).transform( QgsPointXY( 2600000 + job, 1200000 ) );
+      } );
+
+      QCOMPARE( cache.count(), 1 );
+      for ( const QgsPointXY &point : points )
+        QVERIFY( qgsDoubleNear( point.y(), 46.95, 0.01 ) );
+    }
+
+    void benchmarkConstruct()
+    {
+      const QgsCoordinateTransformContext context;
+      QBENCHMARK
+      {
+        const QgsCoordinateTransform transform( mLv95, mWgs84, context );
+        transform.transform( QgsPointXY( 2600000, 1200000 ) );
+      }
+    }
+
+    void benchmarkCached()
+    {
+      CoordinateTransformCache cache;
+      const QgsCoordinateTransformContext context;
+      QBENCHMARK
+      {
+        cache.transform( mLv95, mWgs84, context ).transform( QgsPointXY( 2600000, 1200000 ) );
+      }
+    }
+
+  private:
+    QgsCoordinateReferenceSystem mLv95;
+    QgsCoordinateReferenceSystem mWgs84;
+};
+
+QFIELDTEST_MAIN( TestCoordinateTransformCache )
+#include "test_coordinatetransformcache.moc"
@@ -0,0 +1,121 @@
+/***************************************************************************
+                        test_distancearea.cpp
+                        --------------------
+  begin                : Oct 2026
+  copyright            : (C) 2026 by QField contributors
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include <QtTest>
+
+#include "qfield_testbase.h"
+
+#include "distancearea.h"
+#include "rubberbandmodel.h"
+
+#include <qgsproject.h>
+
+
+class TestDistanceArea: public QObject
+{
+    Q_OBJECT
+  private slots:
+    void initTestCase()
+    {
+      mLv95 = QgsCoordinateReferenceSystem( QStringLiteral( "EPSG:2056" ) );
+      mProject.setCrs( mLv95 );
+      mProject.setEllipsoid( QStringLiteral( "EPSG:7004" ) );
+    }
+
+    void testIncrementalMeasurement()
+    {
+      RubberbandModel model;
+      model.setCrs( mLv95 );
+      model.setGeometryType( QgsWkbTypes::PolygonGeometry );
+
+      DistanceArea distanceArea;
+      distanceArea.setProject( &mProject );
+      distanceArea.setCrs( mLv95 );
+      distanceArea.setRubberbandModel( &model );
+
+      // Digitize a square, the current coordinate follows the cursor
+      model.addVertexFromPoint( QgsPoint( 2600000, 1200000 ) );
+      model.addVertexFromPoint( QgsPoint( 2600100, 1200000 ) );
+      model.addVertexFromPoint( QgsPoint( 2600100, 1200100 ) );
+      model.setCurrentCoordinate( QgsPoint( 2600000, 1200100 ) );
+      compareWithFullMeasurement( distanceArea, model );
+      QVERIFY( qgsDoubleNear( distanceArea.segmentLength(), 100, 0.1 ) );
+
+      // Moving the last vertex only changes the last segment and triangle
+      model.setCurrentCoordinate( QgsPoint( 2600050, 1200150 ) );
+      compareWithFullMeasurement( distanceArea, model );
+
+      // Moving the first vertex changes all triangles
+      model.setVertex( 0, QgsPoint( 2599990, 1199990 ) );
+      compareWithFullMeasurement( distanceArea, model );
+
+      // Vertices inserted and removed in the middle
+      model.setCurrentCoordinateIndex( 1 );
+      model.addVertexFromPoint( QgsPoint( 2600050, 1199950 ) );
+      compareWithFullMeasurement( distanceArea, model );
+      model.removeVertices( 2, 1 );
+      compareWithFullMeasurement( distanceArea, model );
+
+      // A concave polygon
+      model.setVertex( 2, QgsPoint( 2600050, 1200050 ) );
+      compareWithFullMeasurement( distanceArea, model );
+
+      model.reset();
+      QCOMPARE( distanceArea.length(), 0.0 );
+      QCOMPARE( distanceArea.area(), 0.0 );
+    }
+
+    void testCrsChange()
+    {
+      RubberbandModel model;
+      model.setCrs( mLv95 );
+
+      DistanceArea distanceArea;
+      distanceArea.setProject( &mProject );
+      distanceArea.setCrs( mLv95 );
+      distanceArea.setRubberbandModel( &model );
+
+      model.addVertexFromPoint( QgsPoint( 2600000, 1200000 ) );
+      model.setCurrentCoordinate( QgsPoint( 2600100, 1200000 ) );
+      const double length = distanceArea.length();
+
+      // Measured again in the new CRS, the ellipsoidal length stays the same
+      distanceArea.setCrs( QgsCoordinateReferenceSystem( QStringLiteral( "EPSG:4326" ) ) );
+      QVERIFY( qgsDoubleNear( distanceArea.length(), length, 0.001 ) );
+
+      // Without an ellipsoid lengths are measured in the CRS units
+      distanceArea.setProject( nullptr );
+      QVERIFY( distanceArea.length() < 0.01 );
+    }
+
+  private:
+    void compareWithFullMeasurement( const DistanceArea &distanceArea, RubberbandModel &model )
+    {
+      QgsDistanceArea reference;
+      reference.setEllipsoid( mProject.ellipsoid() );
+      reference.setSourceCrs( mLv95, mProject.transformContext() );
+
+      const QVector<QgsPointXY> points = model.flatPointSequence( mLv95 );
+      QVERIFY( qgsDoubleNear( distanceArea.length(), reference.measureLine( points ), 0.0001 ) );
+      QVERIFY( qgsDoubleNear( distanceArea.area(), reference.measurePolygon( points ), 0.01 ) );
+    }
+
+    QgsProject mProject;
+    QgsCoordinateReferenceSystem mLv95;
+};
+
+QFIELDTEST_MAIN( TestDistanceArea )
+#include "test_distancearea.moc"
@@ -0,0 +1,279 @@
+/***************************************************************************
+                        test_featurelistmodel.cpp
+                        --------------------
+  begin                : Oct 2026
+  copyright            : (C) 2026 by QField contributors
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include <QtTest>
+
+#include "qfield_testbase.h"
+
+#include "featurelistmodel.h"
+
+#include <qgsvectordataprovider.h>
+#include <qgsvectorlayer.h>
+
+
+class TestFeatureListModel: public QObject
+{
+    Q_OBJECT
+  private slots:
+    void initTestCase()
+    {
+      mLayer = std::unique_ptr<QgsVectorLayer>( new QgsVectorLayer( QStringLiteral( "None?field=id:integer&field=name:string" ), QStringLiteral( "lookup" ), QStringLiteral( "memory" ) ) );
+      QVERIFY( mLayer->isValid() );
+      mLayer->setDisplayExpression( QStringLiteral( "name" ) );
+
+      QgsFeatureList features;
+      for ( int i = 0; i < 5000; ++i )
+      {
+        QgsFeature feature( mLayer->fields() );
+        feature.setAttributes( QgsAttributes() << i << QStringLiteral( "value %1" ).arg( i, 4, 10, QChar( '0' ) ) );
+        features << feature;
+      }
+      QVERIFY( mLayer->dataProvider()->addFeatures( features ) );
+    }
+
+    void testChunkedLoading()
+    {
+      FeatureListModel model;
+      QSignalSpy insertedSpy( &model, SIGNAL( rowsInserted( QModelIndex, int, int ) ) );
+
+      model.setKeyField( QStringLiteral( "id" ) );
+      model.setAddNull( true );
+      model.setCurrentLayer( mLayer.get() );
+      QVERIFY( model.isLoading() );
+
+      QTRY_VERIFY( !model.isLoading() );
+      QCOMPARE( model.rowCount( QModelIndex() ), 5001 );
+      QVERIFY( insertedSpy.count() >= 1 );
+
+      // The null entry comes first, followed by the features in the order of the layer
+      QVERIFY( model.dataFromRowIndex( 0, FeatureListModel::KeyFieldRole ).isNull() );
+      QCOMPARE( model.dataFromRowIndex( 1, FeatureListModel::DisplayStringRole ).toString(), QStringLiteral( "value 0000" ) );
+      QCOMPARE( model.findKey( 4999 ), 5000 );
+      QCOMPARE( model.findKey( QVariant() ), 0 );
+    }
+
+    void testKeyLookup()
+    {
+      FeatureListModel model;
+      model.setKeyField( QStringLiteral( "id" ) );
+      model.setOrderByValue( true );
+      model.setCurrentLayer( mLayer.get() );
+      QTRY_VERIFY( !model.isLoading() );
+
+      QCOMPARE( model.findKey( 1234 ), 1234 );
+      // Keys compare like QVariant does, across types
+      QCOMPARE( model.findKey( QStringLiteral( "1234" ) ), 1234 );
+      QCOMPARE( model.findKey( 99999 ), -1 );
+      QCOMPARE( model.findKeys( QVariantList() << 3 << 99999 << 42 ), QList<int>() << 3 << -1 << 42 );
+
+      QCOMPARE( model.getFeatureFromKeyValue( 42 ).attribute( QStringLiteral( "name" ) ).toString(), QStringLiteral( "value 0042" ) );
+
+      // Many keys are resolved with a single request, in the order of the keys
+      const QList<QgsFeature> features = model.getFeaturesFromKeyValues( QVariantList() << 7 << 99999 << 5 );
+      QCOMPARE( features.size(), 2 );
+      QCOMPARE( features.at( 0 ).attribute( QStringLiteral( "id" ) ).toInt(), 7 );
+      QCOMPARE( features.at( 1 ).attribute( QStringLiteral( "id" ) ).toInt(), 5 );
+    }
+
+    void benchmarkFindKey()
+    {
+      FeatureListModel model;
+      model.setKeyField( QStringLiteral( "id" ) );
+      model.setCurrentLayer( mLayer.get() );
+      QTRY_VERIFY( !model.isLoading() );
+
+      QBENCHMARK
+      {
+        for ( int i = 0; i < 5000; i += 50 )
+          model.findKey( i );
+      }
+    }
+
+    void testOrderByValue()
+    {
+      FeatureListModel model;
+      model.setKeyField( QStringLiteral( "id" ) );
+      model.setOrderByValue( true );
+      model.setFilterExpression( QStringLiteral( "id % 2 = 0" ) );
+      model.setCurrentLayer( mLayer.get() );
+
+      QTRY_VERIFY( !model.isLoading() );
+      QCOMPARE( model.rowCount( QModelIndex() ), 2500 );
+      for ( int row = 1; row < model.rowCount( QModelIndex() ); ++row )
+        QVERIFY( model.dataFromRowIndex( row - 1, Qt::DisplayRole ).toString() < model.dataFromRowIndex( row, Qt::DisplayRole ).toString() );
+    }
+
+    void testCancelStaleLoad()
+    {
+      FeatureListModel model;
+      model.setKeyField( QStringLiteral( "id" ) );
+      model.setCurrentLayer( mLayer.get() );
+
+      // Wait for the load to start, then change the filter
+      QTRY_VERIFY( model.rowCount( QModelIndex() ) > 0 || !model.isLoading() );
+      model.setFilterExpression( QStringLiteral( "id < 10" ) );
+      QVERIFY( model.isLoading() );
+
+      // Only the entries of the last load remain
+      QTRY_VERIFY( !model.isLoading() );
+      QCOMPARE( model.rowCount( QModelIndex() ), 10 );
+    }
+
+    void testPagedLoading()
+    {
+      FeatureListModel model;
+      model.setKeyField( QStringLiteral( "id" ) );
+      model.setOrderByValue( true );
+      model.setAddNull( true );
+      model.setPageSize( 100 );
+      model.setCurrentLayer( mLayer.get() );
+      QTRY_VERIFY( !model.isLoading() );
+
+      // Only the first page is fetched
+      QCOMPARE( model.rowCount( QModelIndex() ), 101 );
+      QVERIFY( model.canFetchMore( QModelIndex() ) );
+      QCOMPARE( model.dataFromRowIndex( 100, Qt::DisplayRole ).toString(), QStringLiteral( "value 0099" ) );
+
+      // The next page continues after the last entry
+      model.fetchMore( QModelIndex() );
+      QVERIFY( model.isLoading() );
+      QVERIFY( !model.canFetchMore( QModelIndex() ) );
+      QTRY_VERIFY( !model.isLoading() );
+      QCOMPARE( model.rowCount( QModelIndex() ), 201 );
+      QCOMPARE( model.dataFromRowIndex( 101, Qt::DisplayRole ).toString(), QStringLiteral( "value 0100" ) );
+      QCOMPARE( model.dataFromRowIndex( 200, Qt::DisplayRole ).toString(), QStringLiteral( "value 0199" ) );
+
+      // Features of pages not fetched yet have no row, but are still found
+      QCOMPARE( model.findKey( 4000 ), -1 );
+      QCOMPARE( model.findKey( QVariant() ), 0 );
+      QCOMPARE( model.getFeatureFromKeyValue( 4000 ).attribute( QStringLiteral( "name" ) ).toString(), QStringLiteral( "value 4000" ) );
+
+      // The search is part of the request
+      model.setSearchTerm( QStringLiteral( "999" ) );
+      QTRY_VERIFY( !model.isLoading() );
+      QCOMPARE( model.rowCount( QModelIndex() ), 6 );
+      QVERIFY( !model.canFetchMore( QModelIndex() ) );
+      QCOMPARE( model.dataFromRowIndex( 5, Qt::DisplayRole ).toString(), QStringLiteral( "value 4999" ) );
+
+      // Search patterns are taken literally
+      model.setSearchTerm( QStringLiteral( "value_" ) );
+      QTRY_VERIFY( !model.isLoading() );
+      QCOMPARE( model.rowCount( QModelIndex() ), 1 );
+    }
+
+    void testPagedNullValues()
+    {
+      QgsVectorLayer layer( QStringLiteral( "None?field=id:integer&field=name:string" ), QStringLiteral( "names" ), QStringLiteral( "memory" ) );
+      QgsFeatureList features;
+      for ( const QVariant &name : { QVariant( QStringLiteral( "b" ) ), QVariant(), QVariant( QStringLiteral( "a" ) ), QVariant(), QVariant( QStringLiteral( "c" ) ) } )
+      {
+        QgsFeature feature( layer.fields() );
+        feature.setAttributes( QgsAttributes() << features.size() << name );
+        features << feature;
+      }
+      QVERIFY( layer.dataProvider()->addFeatures( features ) );
+
+      FeatureListModel model;
+      model.setKeyField( QStringLiteral( "id" ) );
+      model.setDisplayValueField( QStringLiteral( "name" ) );
+      model.setOrderByValue( true );
+      model.setPageSize( 2 );
+      model.setCurrentLayer( &layer );
+      QTRY_VERIFY( !model.isLoading() );
+
+      // Null values come first and do not end the pagination
+      QCOMPARE( model.rowCount( QModelIndex() ), 2 );
+      QCOMPARE( model.findKey( 1 ), 0 );
+      QCOMPARE( model.findKey( 3 ), 1 );
+
+      while ( model.canFetchMore( QModelIndex() ) )
+      {
+        model.fetchMore( QModelIndex() );
+        QTRY_VERIFY( !model.isLoading() );
+      }
+      QCOMPARE( model.rowCount( QModelIndex() ), 5 );
+      QCOMPARE( model.dataFromRowIndex( 2, Qt::DisplayRole ).toString(), QStringLiteral( "a" ) );
+      QCOMPARE( model.dataFromRowIndex( 4, Qt::DisplayRole ).toString(), QStringLiteral( "c" ) );
+    }
+
+    void testIncrementalUpdates()
+    {
+      QgsVectorLayer layer( QStringLiteral( "None?field=id:integer&field=name:string&field=comment:string" ), QStringLiteral( "colors" ), QStringLiteral( "memory" ) );
+      layer.setDisplayExpression( QStringLiteral( "name" ) );
+      QgsFeatureList features;
+      for ( const QString &name : { QStringLiteral( "blue" ), QStringLiteral( "green" ), QStringLiteral( "red" ) } )
+      {
+        QgsFeature feature( layer.fields() );
+        feature.setAttributes( QgsAttributes() << features.size() << name << QString() );
+        features << feature;
+      }
+      QVERIFY( layer.dataProvider()->addFeatures( features ) );
+
+      FeatureListModel model;
+      model.setKeyField( QStringLiteral( "id" ) );
+      model.setOrderByValue( true );
+      model.setFilterExpression( QStringLiteral( "name <> 'black'" ) );
+      model.setCurrentLayer( &layer );
+      QTRY_VERIFY( !model.isLoading() );
+
+      QSignalSpy resetSpy( &model, SIGNAL( modelReset() ) );
+
+      // A new feature is inserted at its position
+      QVERIFY( layer.startEditing() );
+      QgsFeature feature( layer.fields() );
+      feature.setAttributes( QgsAttributes() << 3 << QStringLiteral( "cyan" ) << QString() );
+      QVERIFY( layer.addFeature( feature ) );
+      QVERIFY( !model.isLoading() );
+      QCOMPARE( model.rowCount( QModelIndex() ), 4 );
+      QCOMPARE( model.findKey( 3 ), 1 );
+      // The following entries moved along
+      QCOMPARE( model.findKey( 2 ), 3 );
+
+      // A changed value moves the entry
+      QVERIFY( layer.changeAttributeValue( feature.id(), 1, QStringLiteral( "yellow" ) ) );
+      QCOMPARE( model.findKey( 3 ), 3 );
+      QCOMPARE( model.dataFromRowIndex( 3, Qt::DisplayRole ).toString(), QStringLiteral( "yellow" ) );
+
+      // A change of a field the entries do not use is ignored
+      QVERIFY( layer.changeAttributeValue( feature.id(), 2, QStringLiteral( "bright" ) ) );
+      QCOMPARE( model.findKey( 3 ), 3 );
+
+      // A feature no longer matching the filter is removed
+      QVERIFY( layer.changeAttributeValue( features.at( 1 ).id(), 1, QStringLiteral( "black" ) ) );
+      QCOMPARE( model.rowCount( QModelIndex() ), 3 );
+      QCOMPARE( model.findKey( 1 ), -1 );
+
+      // Committing replaces the temporary id of the new feature
+      QVERIFY( layer.commitChanges() );
+      QCOMPARE( model.rowCount( QModelIndex() ), 3 );
+      QVERIFY( !FID_IS_NEW( model.getFeatureFromKeyValue( 3 ).id() ) );
+
+      QVERIFY( layer.startEditing() );
+      QVERIFY( layer.deleteFeature( features.at( 0 ).id() ) );
+      QCOMPARE( model.rowCount( QModelIndex() ), 2 );
+      QCOMPARE( model.findKey( 2 ), 0 );
+      QVERIFY( layer.rollBack() );
+      QCOMPARE( model.rowCount( QModelIndex() ), 3 );
+
+      QCOMPARE( resetSpy.count(), 0 );
+    }
+
+  private:
+    std::unique_ptr<QgsVectorLayer> mLayer;
+};
+
+QFIELDTEST_MAIN( TestFeatureListModel )
+#include "test_featurelistmodel.moc"
@@ -94,6 +94,41 @@ class TestGeometryUtils: public QObject
     }
 
 
+    void testTransformCoordinates()
+    {
+      const QgsCoordinateTransform transform( QgsCoordinateReferenceSystem::fromEpsgId( 4326 ), QgsCoordinateReferenceSystem::fromEpsgId( 2056 ), QgsCoordinateTransformContext() );
+
+      QVector<double> x;
+      QVector<double> y;
+      for ( int i = 0; i < 10000; ++i )
+      {
+        x << 7.4 + i * 0.00001;
+        y << 46.9;
+      }
+
+      // The batch gives the same result as transforming point by point
+      QVector<double> z;
+      QVector<double> transformedX = x;
+      QVector<double> transformedY = y;
+      GeometryUtils::transformCoordinates( transform, transformedX, transformedY, z );
+      QVERIFY( z.isEmpty() );
+      for ( int i = 0; i < x.size(); i += 1000 )
+      {
+        const QgsPointXY point = transform.transform( x.at( i ), y.at( i ) );
+        QVERIFY( qgsDoubleNear( transformedX.at( i ), point.x(), 0.0001 ) );
+        QVERIFY( qgsDoubleNear( transformedY.at( i ), point.y(), 0.0001 ) );
+      }
+
+      // Vertices of the rubberband are transformed in one batch as well
+      mModel->setCrs( QgsCoordinateReferenceSystem::fromEpsgId( 4326 ) );
+      mModel->addVertexFromPoint( QgsPoint( 7.4, 46.9 ) );
+      const QVector<QgsPointXY> sequence = mModel->flatPointSequence( QgsCoordinateReferenceSystem::fromEpsgId( 2056 ) );
+      QVERIFY( qgsDoubleNear( sequence.at( 0 ).x(), transformedX.at( 0 ), 0.0001 ) );
+      QVERIFY( qgsDoubleNear( sequence.at( 0 ).y(), transformedY.at( 0 ), 0.0001 ) );
+      mModel->setCrs( QgsCoordinateReferenceSystem() );
+    }
+
+
   private:
     std::unique_ptr<RubberbandModel> mModel;
     std::unique_ptr<QgsVectorLayer> mLayer;
@@ -0,0 +1,165 @@
+/***************************************************************************
+                        test_maprenderingbenchmark.cpp
+                        --------------------
+  begin                : Oct 2026
+  copyright            : (C) 2026 by QField contributors
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include <QtTest>
+
+#include "qfield_testbase.h"
+
+#include "qgsquickmapcanvasmap.h"
+#include "qgsquickmapsettings.h"
+
+#include <qgslayertree.h>
+#include <qgsproject.h>
+
+#include <algorithm>
+#include <cmath>
+
+
+/**
+ * Renders projects through QgsQuickMapCanvasMap with a scripted sequence of pans and zooms
+ * and reports the latency from an extent change until the map is fully rendered.
+ *
+ * The bundled demo projects are always used. Additional projects (e.g. from QGIS-Sampledata)
+ * can be passed with the QFIELD_BENCHMARK_PROJECTS environment variable, a list of project
+ * files or directories separated by the platform's path list separator.
+ *
+ * The median latency is reported as benchmark result, all percentiles are printed.
+ */
+class TestMapRenderingBenchmark: public QObject
+{
+    Q_OBJECT
+  private slots:
+    void benchmarkPanZoom_data()
+    {
+      QTest::addColumn<QString>( "projectPath" );
+      QTest::addColumn<bool>( "tiledRendering" );
+
+      QStringList projectPaths;
+      const QDir demoProjects( QStringLiteral( QFIELD_DEMO_PROJECTS_DIR ) );
+      projectPaths << demoProjects.filePath( QStringLiteral( "simple_bee_farming.qgs" ) )
+                   << demoProjects.filePath( QStringLiteral( "advanced_bee_farming.qgs" ) );
+
+      const QStringList extraPaths = qEnvironmentVariable( "QFIELD_BENCHMARK_PROJECTS" ).split( QDir::listSeparator(), QString::SkipEmptyParts );
+      for ( const QString &path : extraPaths )
+      {
+        const QFileInfo fi( path );
+        if ( fi.isDir() )
+        {
+          QDirIterator it( path, QStringList() << QStringLiteral( "*.qgs" ) << QStringLiteral( "*.qgz" ), QDir::Files, QDirIterator::Subdirectories );
+          while ( it.hasNext() )
+            projectPaths << it.next();
+        }
+        else
+        {
+          projectPaths << path;
+        }
+      }
+
+      for ( const QString &projectPath : qgis::as_const( projectPaths ) )
+      {
+        const QString name = QFileInfo( projectPath ).completeBaseName();
+        QTest::newRow( QStringLiteral( "%1 (untiled)" ).arg( name ).toUtf8().constData() ) << projectPath << false;
+        QTest::newRow( QStringLiteral( "%1 (tiled)" ).arg( name ).toUtf8().constData() ) << projectPath << true;
+      }
+    }
+
+    void benchmarkPanZoom()
+    {
+      QFETCH( QString, projectPath );
+      QFETCH( bool, tiledRendering );
+
+      QgsProject project;
+      QgsQuickMapCanvasMap canvas;
+      QgsQuickMapSettings *settings = canvas.mapSettings();
+      settings->setProject( &project );
+      canvas.setTiledRendering( tiledRendering );
+
+      QVERIFY2( project.read( projectPath ), projectPath.toUtf8().constData() );
+      settings->setOutputSize( QSize( 1280, 800 ) );
+      settings->setLayers( project.layerTreeRoot()->checkedLayers() );
+
+      // Cold render, not part of the measurements
+      QVERIFY( waitForRender( canvas ) );
+
+      const QgsRectangle initialExtent = settings->extent();
+      QList<double> latencies;
+
+      const auto measure = [&]( const QgsRectangle & extent )
+      {
+        QElapsedTimer timer;
+        timer.start();
+        settings->setExtent( extent );
+        if ( waitForRender( canvas ) )
+          latencies << timer.nsecsElapsed() / 1000000.0;
+      };
+
+      // Pan by a quarter of the extent in each direction and back
+      const double dx = initialExtent.width() / 4;
+      const double dy = initialExtent.height() / 4;
+      const QList<QPointF> panSteps { { dx, 0 }, { dx, 0 }, { 0, dy }, { 0, dy }, { -dx, 0 }, { -dx, 0 }, { 0, -dy }, { 0, -dy } };
+      QgsRectangle extent = initialExtent;
+      for ( const QPointF &step : panSteps )
+      {
+        extent = QgsRectangle( extent.xMinimum() + step.x(), extent.yMinimum() + step.y(),
+                               extent.xMaximum() + step.x(), extent.yMaximum() + step.y() );
+        measure( extent );
+      }
+
+      // Zoom in three times, out again past the initial extent and back
+      const QList<double> zoomSteps { 0.5, 0.5, 0.5, 2, 2, 2, 2, 0.5 };
+      for ( double factor : zoomSteps )
+      {
+        extent.scale( factor );
+        measure( extent );
+      }
+
+      QVERIFY( !latencies.isEmpty() );
+      std::sort( latencies.begin(), latencies.end() );
+
+      qInfo( "%s: p50 %.1f ms, p90 %.1f ms, p99 %.1f ms, max %.1f ms (%d renders)",
+             QTest::currentDataTag(),
+             percentile( latencies, 50 ), percentile( latencies, 90 ), percentile( latencies, 99 ),
+             latencies.last(), latencies.size() );
+
+      QTest::setBenchmarkResult( percentile( latencies, 50 ), QTest::WalltimeMilliseconds );
+    }
+
+  private:
+    //! Waits until a refresh has been shown and no rendering job is left
+    bool waitForRender( QgsQuickMapCanvasMap &canvas, int timeout = 60000 )
+    {
+      QSignalSpy refreshedSpy( &canvas, &QgsQuickMapCanvasMap::mapCanvasRefreshed );
+      QElapsedTimer timer;
+      timer.start();
+      while ( timer.elapsed() < timeout )
+      {
+        QCoreApplication::processEvents( QEventLoop::AllEvents, 5 );
+        if ( refreshedSpy.count() > 0 && !canvas.isRendering() )
+          return true;
+      }
+      return false;
+    }
+
+    //! Returns the nearest rank \a percent percentile of the sorted \a values
+    static double percentile( const QList<double> &values, double percent )
+    {
+      const int rank = static_cast<int>( std::ceil( percent / 100 * values.size() ) );
+      return values.at( std::max( 0, std::min( rank, values.size() ) - 1 ) );
+    }
+};
+
+QFIELDTEST_MAIN( TestMapRenderingBenchmark )
+#include "test_maprenderingbenchmark.moc"
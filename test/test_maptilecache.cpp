@@ -0,0 +1,151 @@
+/***************************************************************************
+                        test_maptilecache.cpp
+                        --------------------
+  begin                : Oct 2026
+  copyright            : (C) 2026 by QField contributors
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include <QtTest>
+
+#include "qfield_testbase.h"
+
+#include "qgsquickmaptilecache.h"
+#include "qgsquickmaptilestore.h"
+
+#include "qgsvectorlayer.h"
+
+
+class TestMapTileCache: public QObject
+{
+    Q_OBJECT
+  private slots:
+    void initTestCase()
+    {
+      mLayer = std::unique_ptr<QgsVectorLayer>( new QgsVectorLayer( QStringLiteral( "Point?crs=epsg:2056" ), QStringLiteral( "vl" ), QStringLiteral( "memory" ) ) );
+
+      mSettings.setDestinationCrs( QgsCoordinateReferenceSystem( QStringLiteral( "EPSG:2056" ) ) );
+      mSettings.setLayers( QList<QgsMapLayer *>() << mLayer.get() );
+      mSettings.setOutputSize( QSize( 512, 512 ) );
+      // 1 map unit per pixel, 256 map units per tile
+      mSettings.setExtent( QgsRectangle( 2600100, 1199900, 2600612, 1200412 ) );
+    }
+
+    void testTileRange()
+    {
+      const QgsQuickMapTileCache::TileRange range = QgsQuickMapTileCache::tileRange( mSettings );
+      QVERIFY( range.isValid() );
+      QCOMPARE( range.columnCount(), 3LL );
+      QCOMPARE( range.rowCount(), 3LL );
+
+      const QgsRectangle extent = QgsQuickMapTileCache::tileRangeExtent( mSettings, range );
+      QVERIFY( extent.contains( mSettings.visibleExtent() ) );
+      QCOMPARE( extent.width(), 3 * 256.0 );
+      QCOMPARE( std::fmod( extent.xMinimum(), 256.0 ), 0.0 );
+      QCOMPARE( std::fmod( extent.yMaximum(), 256.0 ), 0.0 );
+
+      const QgsMapSettings tileSettings = QgsQuickMapTileCache::tileRangeMapSettings( mSettings, range );
+      QCOMPARE( tileSettings.outputSize(), QSize( 768, 768 ) );
+      QCOMPARE( QgsQuickMapTileCache::contextKey( tileSettings ), QgsQuickMapTileCache::contextKey( mSettings ) );
+    }
+
+    void testMissingTiles()
+    {
+      QgsQuickMapTileCache cache;
+      const QString context = QgsQuickMapTileCache::contextKey( mSettings );
+      const QgsQuickMapTileCache::TileRange range = QgsQuickMapTileCache::tileRange( mSettings );
+
+      QList<QgsQuickMapTileCache::TileRange> missing = cache.missingTiles( context, range );
+      QCOMPARE( missing.size(), 1 );
+      QCOMPARE( missing.at( 0 ), range );
+
+      // Cache the left column only, the remaining tiles are merged into a single block
+      QgsQuickMapTileCache::TileRange leftColumn( range.firstColumn, range.firstColumn, range.firstRow, range.lastRow );
+      QImage image( 256, 3 * 256, QImage::Format_ARGB32_Premultiplied );
+      image.fill( Qt::red );
+      cache.insertTiles( context, leftColumn, image );
+
+      missing = cache.missingTiles( context, range );
+      QCOMPARE( missing.size(), 1 );
+      QCOMPARE( missing.at( 0 ), QgsQuickMapTileCache::TileRange( range.firstColumn + 1, range.lastColumn, range.firstRow, range.lastRow ) );
+
+      // A different scale level does not share tiles
+      QgsMapSettings zoomedSettings( mSettings );
+      zoomedSettings.setExtent( QgsRectangle( 2600100, 1199900, 2601124, 1200924 ) );
+      QVERIFY( QgsQuickMapTileCache::contextKey( zoomedSettings ) != context );
+
+      QImage composed( 3 * 256, 3 * 256, QImage::Format_ARGB32_Premultiplied );
+      composed.fill( Qt::transparent );
+      cache.drawTiles( context, range, composed );
+      QCOMPARE( composed.pixelColor( 10, 600 ), QColor( Qt::red ) );
+      QCOMPARE( composed.pixelColor( 600, 10 ).alpha(), 0 );
+
+      // Tiles rendered before the invalidation can be told apart by the generation
+      const int generation = cache.generation();
+      cache.invalidateLayer( mLayer->id() );
+      QVERIFY( !cache.hasTile( context, range.firstColumn, range.firstRow ) );
+      QVERIFY( cache.generation() != generation );
+    }
+
+    void testTileStore()
+    {
+      QTemporaryDir dir;
+      QVERIFY( dir.isValid() );
+      const QString path = QgsQuickMapTileStore::storePath( dir.filePath( QStringLiteral( "project.qgs" ) ) );
+      QCOMPARE( QFileInfo( path ).dir().path(), dir.path() );
+
+      const QString context = QgsQuickMapTileCache::contextKey( mSettings );
+      const QgsQuickMapTileCache::TileRange range( 4, 5, -2, -2 );
+      QImage image( 2 * 256, 256, QImage::Format_ARGB32_Premultiplied );
+      image.fill( Qt::blue );
+
+      {
+        QgsQuickMapTileStore store( path );
+        QVERIFY( store.isValid() );
+        store.validateLayers( QList<QgsMapLayer *>() << mLayer.get() );
+
+        // Writes based on an outdated generation are dropped
+        const int generation = store.generation();
+        store.invalidateLayer( QStringLiteral( "other_layer" ) );
+        store.writeTiles( context, range, image, generation );
+        QVERIFY( store.readTile( context, 4, -2 ).isNull() );
+
+        store.writeTiles( context, range, image, store.generation() );
+        QCOMPARE( store.readTile( context, 5, -2 ).pixelColor( 0, 0 ), QColor( Qt::blue ) );
+      }
+
+      // Tiles survive reopening the store as long as the layer did not change
+      QgsQuickMapTileStore store( path );
+      QVERIFY( store.isValid() );
+      store.validateLayers( QList<QgsMapLayer *>() << mLayer.get() );
+      QCOMPARE( store.readTile( context, 4, -2 ).size(), QSize( 256, 256 ) );
+
+      const QgsQuickMapTileStore::TileImages tiles = store.readTiles( context, QList<QgsQuickMapTileCache::TileRange>() << QgsQuickMapTileCache::TileRange( 3, 6, -3, -1 ) );
+      QCOMPARE( tiles.size(), 2 );
+      QVERIFY( tiles.contains( qMakePair( 4LL, -2LL ) ) );
+      QVERIFY( tiles.contains( qMakePair( 5LL, -2LL ) ) );
+
+      // Invalidated tiles are not read anymore, even before they are removed
+      store.invalidateLayer( mLayer->id() );
+      QVERIFY( store.readTile( context, 4, -2 ).isNull() );
+
+      store.flushInvalidations();
+      QVERIFY( store.readTile( context, 4, -2 ).isNull() );
+      QVERIFY( store.readTiles( context, QList<QgsQuickMapTileCache::TileRange>() << range ).isEmpty() );
+    }
+
+  private:
+    std::unique_ptr<QgsVectorLayer> mLayer;
+    QgsMapSettings mSettings;
+};
+
+QFIELDTEST_MAIN( TestMapTileCache )
+#include "test_maptilecache.moc"
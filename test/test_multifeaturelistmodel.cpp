@@ -0,0 +1,193 @@
+/***************************************************************************
+                        test_multifeaturelistmodel.cpp
+                        --------------------
+  begin                : Oct 2026
+  copyright            : (C) 2026 by QField contributors
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include <QtTest>
+
+#include "qfield_testbase.h"
+
+#include "multifeaturelistmodel.h"
+#include "multifeaturelistmodelbase.h"
+
+#include <qgsvectordataprovider.h>
+#include <qgsvectorlayer.h>
+
+
+class TestMultiFeatureListModel: public QObject
+{
+    Q_OBJECT
+  private slots:
+    void initTestCase()
+    {
+      mLayer = std::unique_ptr<QgsVectorLayer>( new QgsVectorLayer( QStringLiteral( "Point?crs=EPSG:4326&field=id:integer" ), QStringLiteral( "points" ), QStringLiteral( "memory" ) ) );
+      QVERIFY( mLayer->isValid() );
+
+      QgsFeatureList features;
+      for ( int i = 0; i < 10; ++i )
+      {
+        QgsFeature feature( mLayer->fields() );
+        feature.setAttributes( QgsAttributes() << i );
+        feature.setGeometry( QgsGeometry::fromPointXY( QgsPointXY( i, i ) ) );
+        features << feature;
+      }
+      QVERIFY( mLayer->dataProvider()->addFeatures( features ) );
+
+      QgsFeature feature;
+      QgsFeatureIterator it = mLayer->getFeatures();
+      while ( it.nextFeature( feature ) )
+        mResults << IdentifyTool::IdentifyResult( mLayer.get(), feature );
+    }
+
+    void testAppendFeatures()
+    {
+      MultiFeatureListModelBase model;
+      QSignalSpy insertedSpy( &model, SIGNAL( rowsInserted( QModelIndex, int, int ) ) );
+
+      model.appendFeatures( mResults.mid( 0, 6 ) );
+      QCOMPARE( model.count(), 6 );
+      QCOMPARE( insertedSpy.count(), 1 );
+      QCOMPARE( insertedSpy.at( 0 ).at( 2 ).toInt(), 5 );
+
+      // Features already in the model and duplicates are not inserted again
+      model.appendFeatures( mResults.mid( 4, 6 ) + mResults.mid( 8, 2 ) );
+      QCOMPARE( model.count(), 10 );
+      QCOMPARE( insertedSpy.count(), 2 );
+      QCOMPARE( insertedSpy.at( 1 ).at( 1 ).toInt(), 6 );
+      QCOMPARE( insertedSpy.at( 1 ).at( 2 ).toInt(), 9 );
+
+      // Nothing new, nothing inserted
+      model.appendFeatures( mResults.mid( 0, 2 ) );
+      QCOMPARE( model.count(), 10 );
+      QCOMPARE( insertedSpy.count(), 2 );
+    }
+
+    void testSelection()
+    {
+      MultiFeatureListModelBase model;
+      model.appendFeatures( mResults.mid( 0, 6 ) );
+
+      QSignalSpy dataChangedSpy( &model, SIGNAL( dataChanged( QModelIndex, QModelIndex, QVector<int> ) ) );
+
+      model.toggleSelectedItem( 4 );
+      model.toggleSelectedItem( 1 );
+      model.toggleSelectedItem( 2 );
+      QCOMPARE( model.selectedCount(), 3 );
+      QVERIFY( model.data( model.index( 2, 0 ), MultiFeatureListModel::FeatureSelectedRole ).toBool() );
+      QVERIFY( !model.data( model.index( 3, 0 ), MultiFeatureListModel::FeatureSelectedRole ).toBool() );
+
+      // In the order of the rows
+      const QList<QgsFeature> selected = model.selectedFeatures();
+      QCOMPARE( selected.size(), 3 );
+      QCOMPARE( selected.at( 0 ).id(), mResults.at( 1 ).feature.id() );
+      QCOMPARE( selected.at( 2 ).id(), mResults.at( 4 ).feature.id() );
+
+      // New features join the selection, selected features found again leave it
+      model.appendFeatures( mResults.mid( 4, 3 ) );
+      QCOMPARE( model.count(), 7 );
+      QCOMPARE( model.selectedCount(), 3 );
+      QVERIFY( !model.data( model.index( 4, 0 ), MultiFeatureListModel::FeatureSelectedRole ).toBool() );
+      QVERIFY( model.data( model.index( 6, 0 ), MultiFeatureListModel::FeatureSelectedRole ).toBool() );
+
+      // Removed rows take their selection along
+      model.removeRows( 0, 2, QModelIndex() );
+      QCOMPARE( model.selectedCount(), 2 );
+      QVERIFY( model.data( model.index( 0, 0 ), MultiFeatureListModel::FeatureSelectedRole ).toBool() );
+      QVERIFY( model.data( model.index( 4, 0 ), MultiFeatureListModel::FeatureSelectedRole ).toBool() );
+
+      // Contiguous rows are announced at once
+      model.toggleSelectedItem( 1 );
+      dataChangedSpy.clear();
+      model.clearSelection();
+      QCOMPARE( model.selectedCount(), 0 );
+      QCOMPARE( dataChangedSpy.count(), 2 );
+      QCOMPARE( dataChangedSpy.at( 0 ).at( 0 ).value<QModelIndex>().row(), 0 );
+      QCOMPARE( dataChangedSpy.at( 0 ).at( 1 ).value<QModelIndex>().row(), 1 );
+      QCOMPARE( dataChangedSpy.at( 1 ).at( 0 ).value<QModelIndex>().row(), 4 );
+    }
+
+    void testClearKeepSelected()
+    {
+      MultiFeatureListModelBase model;
+      model.appendFeatures( mResults );
+      model.toggleSelectedItem( 7 );
+      model.toggleSelectedItem( 3 );
+
+      model.clear( true );
+      QCOMPARE( model.count(), 2 );
+      QCOMPARE( model.selectedCount(), 2 );
+      QCOMPARE( model.data( model.index( 0, 0 ), MultiFeatureListModel::FeatureIdRole ).value<QgsFeatureId>(), mResults.at( 3 ).feature.id() );
+
+      // The index follows the kept features
+      model.appendFeatures( mResults.mid( 7, 1 ) );
+      QCOMPARE( model.count(), 2 );
+    }
+
+    void testDeleteSelection()
+    {
+      QgsVectorLayer layer( QStringLiteral( "Point?crs=EPSG:4326&field=id:integer" ), QStringLiteral( "deleted" ), QStringLiteral( "memory" ) );
+      QgsFeatureList features;
+      for ( int i = 0; i < 10; ++i )
+      {
+        QgsFeature feature( layer.fields() );
+        feature.setAttributes( QgsAttributes() << i );
+        features << feature;
+      }
+      QVERIFY( layer.dataProvider()->addFeatures( features ) );
+
+      QList<IdentifyTool::IdentifyResult> results;
+      QgsFeature feature;
+      QgsFeatureIterator it = layer.getFeatures();
+      while ( it.nextFeature( feature ) )
+        results << IdentifyTool::IdentifyResult( &layer, feature );
+
+      MultiFeatureListModelBase model;
+      model.appendFeatures( results );
+      model.toggleSelectedItem( 1 );
+      model.toggleSelectedItem( 5 );
+      model.toggleSelectedItem( 6 );
+
+      // Scattered rows are removed at once, after all features are deleted
+      QSignalSpy resetSpy( &model, SIGNAL( modelReset() ) );
+      QSignalSpy removedSpy( &model, SIGNAL( rowsRemoved( QModelIndex, int, int ) ) );
+      QVERIFY( model.deleteSelection() );
+      QCOMPARE( model.count(), 7 );
+      QCOMPARE( model.selectedCount(), 0 );
+      QCOMPARE( resetSpy.count(), 1 );
+      QCOMPARE( removedSpy.count(), 0 );
+      QCOMPARE( layer.featureCount(), 7LL );
+      QCOMPARE( model.data( model.index( 1, 0 ), MultiFeatureListModel::FeatureIdRole ).value<QgsFeatureId>(), results.at( 2 ).feature.id() );
+      QCOMPARE( model.data( model.index( 4, 0 ), MultiFeatureListModel::FeatureIdRole ).value<QgsFeatureId>(), results.at( 7 ).feature.id() );
+
+      // Contiguous rows are removed as a range
+      model.toggleSelectedItem( 2 );
+      model.toggleSelectedItem( 3 );
+      resetSpy.clear();
+      QVERIFY( model.deleteSelection() );
+      QCOMPARE( model.count(), 5 );
+      QCOMPARE( resetSpy.count(), 0 );
+      QCOMPARE( removedSpy.count(), 1 );
+
+      // The index follows the remaining features
+      model.appendFeatures( results.mid( 9, 1 ) );
+      QCOMPARE( model.count(), 5 );
+    }
+
+  private:
+    std::unique_ptr<QgsVectorLayer> mLayer;
+    QList<IdentifyTool::IdentifyResult> mResults;
+};
+
+QFIELDTEST_MAIN( TestMultiFeatureListModel )
+#include "test_multifeaturelistmodel.moc"
@@ -0,0 +1,148 @@
+/***************************************************************************
+                        test_qgsquickmapcanvasmap.cpp
+                        --------------------
+  begin                : Oct 2026
+  copyright            : (C) 2026 by QField contributors
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include <QtTest>
+
+#include "qfield_testbase.h"
+
+#include "qgsquickmapcanvasmap.h"
+#include "qgsquickmapsettings.h"
+
+#include "qgsvectorlayer.h"
+
+#include <atomic>
+
+/**
+ * A vector layer which counts how often it is rendered. Layers taken from the
+ * renderer cache do not get a renderer.
+ */
+class RenderCountingLayer : public QgsVectorLayer
+{
+  public:
+    using QgsVectorLayer::QgsVectorLayer;
+
+    QgsMapLayerRenderer *createMapRenderer( QgsRenderContext &context ) override
+    {
+      renderCount++;
+      return QgsVectorLayer::createMapRenderer( context );
+    }
+
+    std::atomic<int> renderCount{ 0 };
+};
+
+
+class TestQgsQuickMapCanvasMap: public QObject
+{
+    Q_OBJECT
+  private slots:
+    void initTestCase()
+    {
+      mPointLayer = std::unique_ptr<RenderCountingLayer>( new RenderCountingLayer( QStringLiteral( "Point?crs=epsg:2056" ), QStringLiteral( "points" ), QStringLiteral( "memory" ) ) );
+      mPolygonLayer = std::unique_ptr<RenderCountingLayer>( new RenderCountingLayer( QStringLiteral( "Polygon?crs=epsg:2056" ), QStringLiteral( "polygons" ), QStringLiteral( "memory" ) ) );
+
+      QgsFeature point( mPointLayer->fields() );
+      point.setGeometry( QgsGeometry::fromWkt( QStringLiteral( "Point (2600050 1200050)" ) ) );
+      QVERIFY( mPointLayer->dataProvider()->addFeature( point ) );
+
+      QgsFeature polygon( mPolygonLayer->fields() );
+      polygon.setGeometry( QgsGeometry::fromWkt( QStringLiteral( "Polygon ((2600000 1200000, 2600100 1200000, 2600100 1200100, 2600000 1200000))" ) ) );
+      QVERIFY( mPolygonLayer->dataProvider()->addFeature( polygon ) );
+    }
+
+    void init()
+    {
+      mPointLayer->renderCount = 0;
+      mPolygonLayer->renderCount = 0;
+    }
+
+    void testPerLayerRendering()
+    {
+      QgsQuickMapCanvasMap canvas;
+      QgsQuickMapSettings *settings = canvas.mapSettings();
+      settings->setDestinationCrs( QgsCoordinateReferenceSystem( QStringLiteral( "EPSG:2056" ) ) );
+      settings->setOutputSize( QSize( 200, 200 ) );
+      settings->setExtent( QgsRectangle( 2600000, 1200000, 2600100, 1200100 ) );
+      settings->setLayers( QList<QgsMapLayer *>() << mPointLayer.get() << mPolygonLayer.get() );
+
+      // Changing the settings schedules a single refresh
+      QSignalSpy refreshedSpy( &canvas, &QgsQuickMapCanvasMap::mapCanvasRefreshed );
+      QVERIFY( refreshedSpy.wait() );
+      QCOMPARE( mPointLayer->renderCount.load(), 1 );
+      QCOMPARE( mPolygonLayer->renderCount.load(), 1 );
+
+      // Only the layer which requested a repaint is rendered again
+      mPointLayer->triggerRepaint();
+      QVERIFY( refreshedSpy.wait() );
+      QCOMPARE( mPointLayer->renderCount.load(), 2 );
+      QCOMPARE( mPolygonLayer->renderCount.load(), 1 );
+      QVERIFY( !canvas.mImage.isNull() );
+
+      // A new extent requires all layers to be rendered
+      settings->setExtent( QgsRectangle( 2600000, 1200000, 2600200, 1200200 ) );
+      QVERIFY( refreshedSpy.wait() );
+      QCOMPARE( mPointLayer->renderCount.load(), 3 );
+      QCOMPARE( mPolygonLayer->renderCount.load(), 2 );
+    }
+
+    void testPrerenderMargin()
+    {
+      QgsQuickMapCanvasMap canvas;
+      canvas.setPrerenderMargin( 0.25 );
+      QgsQuickMapSettings *settings = canvas.mapSettings();
+      settings->setDestinationCrs( QgsCoordinateReferenceSystem( QStringLiteral( "EPSG:2056" ) ) );
+      settings->setOutputSize( QSize( 200, 200 ) );
+      settings->setExtent( QgsRectangle( 2600000, 1200000, 2600100, 1200100 ) );
+      settings->setLayers( QList<QgsMapLayer *>() << mPointLayer.get() );
+
+      QSignalSpy refreshedSpy( &canvas, &QgsQuickMapCanvasMap::mapCanvasRefreshed );
+      QVERIFY( refreshedSpy.wait() );
+      QVERIFY( canvas.mImagePrerendered );
+      QCOMPARE( canvas.mImage.size(), QSize( 300, 300 ) );
+      QCOMPARE( mPointLayer->renderCount.load(), 1 );
+
+      // Panning by less than half of the margin only moves the image
+      settings->setExtent( QgsRectangle( 2600010, 1200000, 2600110, 1200100 ) );
+      QVERIFY( !refreshedSpy.wait( 500 ) );
+      QCOMPARE( mPointLayer->renderCount.load(), 1 );
+
+      // Panning further renders a new image around the new extent
+      settings->setExtent( QgsRectangle( 2600020, 1200000, 2600120, 1200100 ) );
+      QVERIFY( refreshedSpy.wait() );
+      QCOMPARE( mPointLayer->renderCount.load(), 2 );
+
+      // The margin is moved ahead of the movement, here towards east, the image starts at the visible extent
+      canvas.setMovementDirection( 90 );
+      settings->setExtent( QgsRectangle( 2600100, 1200000, 2600200, 1200100 ) );
+      QVERIFY( refreshedSpy.wait() );
+      QVERIFY( qgsDoubleNear( canvas.mImageMapSettings.visibleExtent().xMinimum(), 2600100, 0.01 ) );
+      QVERIFY( qgsDoubleNear( canvas.mImageMapSettings.visibleExtent().xMaximum(), 2600250, 0.01 ) );
+
+      // Zooming back into the image while a job renders another scale does not keep the result of that job
+      QSignalSpy startedSpy( &canvas, &QgsQuickMapCanvasMap::renderStarting );
+      settings->setExtent( QgsRectangle( 2600100, 1200000, 2600300, 1200200 ) );
+      QVERIFY( startedSpy.wait() );
+      settings->setExtent( QgsRectangle( 2600100, 1200000, 2600200, 1200100 ) );
+      QTRY_VERIFY( !canvas.isRendering() );
+      QVERIFY( qgsDoubleNear( canvas.mImageMapSettings.mapUnitsPerPixel(), settings->mapSettings().mapUnitsPerPixel(), 1e-6 ) );
+    }
+
+  private:
+    std::unique_ptr<RenderCountingLayer> mPointLayer;
+    std::unique_ptr<RenderCountingLayer> mPolygonLayer;
+};
+
+QFIELDTEST_MAIN( TestQgsQuickMapCanvasMap )
+#include "test_qgsquickmapcanvasmap.moc"
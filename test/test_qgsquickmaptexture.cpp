@@ -0,0 +1,108 @@
+/***************************************************************************
+                        test_qgsquickmaptexture.cpp
+                        --------------------
+  begin                : Oct 2026
+  copyright            : (C) 2026 by QField contributors
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include <QtTest>
+#include <QOffscreenSurface>
+#include <QOpenGLContext>
+#include <QOpenGLFunctions>
+#include <QQuickRenderControl>
+#include <QQuickWindow>
+
+#include "qfield_testbase.h"
+
+#include "qgsquickmaptexture.h"
+
+
+/**
+ * Compares the per frame cost of uploading a 4K map image into a new texture from
+ * QQuickWindow::createTextureFromImage, the path used before, with updating a reused QgsQuickMapTexture.
+ */
+class TestQgsQuickMapTexture: public QObject
+{
+    Q_OBJECT
+  private slots:
+    void initTestCase()
+    {
+      mSurface.create();
+      if ( !mContext.create() || !mContext.makeCurrent( &mSurface ) )
+        QSKIP( "No OpenGL context available" );
+
+      // An offscreen window whose scene graph renders with our context, to create textures like the canvas did
+      mRenderControl.reset( new QQuickRenderControl() );
+      mWindow.reset( new QQuickWindow( mRenderControl.get() ) );
+      mRenderControl->initialize( &mContext );
+
+      mImage = QImage( 3840, 2160, QImage::Format_ARGB32_Premultiplied );
+      mImage.fill( QColor( 120, 160, 80 ) );
+    }
+
+    void testUpdateInPlace()
+    {
+      QgsQuickMapTexture texture;
+      texture.setImage( mImage );
+      texture.bind();
+      const int textureId = texture.textureId();
+      QVERIFY( textureId != 0 );
+
+      QImage other( mImage.size(), QImage::Format_ARGB32_Premultiplied );
+      other.fill( Qt::red );
+      texture.setImage( other );
+      texture.bind();
+      QCOMPARE( texture.textureId(), textureId );
+      QCOMPARE( texture.textureSize(), mImage.size() );
+      // The image is shared, not copied
+      QCOMPARE( texture.image().constBits(), other.constBits() );
+    }
+
+    void benchmarkCreateTextureFromImage()
+    {
+      QOpenGLFunctions *funcs = mContext.functions();
+      QBENCHMARK
+      {
+        QSGTexture *texture = mWindow->createTextureFromImage( mImage );
+        QVERIFY( texture );
+        texture->bind();
+        funcs->glFinish();
+        delete texture;
+      }
+    }
+
+    void benchmarkReusedTexture()
+    {
+      QOpenGLFunctions *funcs = mContext.functions();
+      QgsQuickMapTexture texture;
+      texture.setImage( mImage );
+      texture.bind();
+
+      QBENCHMARK
+      {
+        texture.setImage( mImage );
+        texture.bind();
+        funcs->glFinish();
+      }
+    }
+
+  private:
+    QOffscreenSurface mSurface;
+    QOpenGLContext mContext;
+    // Destroyed in reverse order, the render control goes before its window
+    std::unique_ptr<QQuickWindow> mWindow;
+    std::unique_ptr<QQuickRenderControl> mRenderControl;
+    QImage mImage;
+};
+
+QFIELDTEST_MAIN( TestQgsQuickMapTexture )
+#include "test_qgsquickmaptexture.moc"
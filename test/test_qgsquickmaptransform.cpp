@@ -0,0 +1,72 @@
+/***************************************************************************
+                        test_qgsquickmaptransform.cpp
+                        --------------------
+  begin                : Oct 2026
+  copyright            : (C) 2026 by QField contributors
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include <QtTest>
+#include <QVector4D>
+
+#include "qfield_testbase.h"
+
+#include "qgsquickmapsettings.h"
+#include "qgsquickmaptransform.h"
+
+#include <cmath>
+
+
+class TestQgsQuickMapTransform: public QObject
+{
+    Q_OBJECT
+  private slots:
+    void testLocalOriginPrecision()
+    {
+      // Zoomed in on a single metre in LV95, 2.5 mm per pixel
+      QgsQuickMapSettings settings;
+      settings.setDestinationCrs( QgsCoordinateReferenceSystem( QStringLiteral( "EPSG:2056" ) ) );
+      settings.setOutputSize( QSize( 400, 400 ) );
+      settings.setExtent( QgsRectangle( 2600000.1, 1200000.2, 2600001.1, 1200001.2 ) );
+
+      const QgsPointXY point( 2600000.3217, 1200000.6143 );
+      const QPointF expected = settings.coordinateToScreen( QgsPoint( point ) );
+      const double mapUnitsPerPoint = settings.mapUnitsPerPoint();
+
+      // Vertices relative to a nearby origin are placed with sub-centimetre precision
+      const QgsPointXY origin( 2600000, 1200000 );
+      const QPointF local = map( QgsQuickMapTransform::matrix( &settings, origin ), point.x() - origin.x(), point.y() - origin.y() );
+      QVERIFY( std::fabs( local.x() - expected.x() ) * mapUnitsPerPoint < 0.01 );
+      QVERIFY( std::fabs( local.y() - expected.y() ) * mapUnitsPerPoint < 0.01 );
+
+      // The same vertex in absolute float coordinates is off by decimetres
+      const QPointF absolute = map( QgsQuickMapTransform::matrix( &settings ), point.x(), point.y() );
+      QVERIFY( std::fabs( absolute.x() - expected.x() ) * mapUnitsPerPoint > 0.01 || std::fabs( absolute.y() - expected.y() ) * mapUnitsPerPoint > 0.01 );
+
+      // Panning only changes the matrix, the local vertex stays valid
+      settings.setExtent( QgsRectangle( 2600000.0, 1200000.0, 2600001.0, 1200001.0 ) );
+      const QPointF panned = map( QgsQuickMapTransform::matrix( &settings, origin ), point.x() - origin.x(), point.y() - origin.y() );
+      const QPointF pannedExpected = settings.coordinateToScreen( QgsPoint( point ) );
+      QVERIFY( std::fabs( panned.x() - pannedExpected.x() ) * mapUnitsPerPoint < 0.01 );
+      QVERIFY( std::fabs( panned.y() - pannedExpected.y() ) * mapUnitsPerPoint < 0.01 );
+    }
+
+  private:
+    //! Maps a float vertex with float arithmetic, as done on the GPU
+    static QPointF map( const QMatrix4x4 &matrix, double x, double y )
+    {
+      const QVector4D vertex = matrix * QVector4D( static_cast<float>( x ), static_cast<float>( y ), 0, 1 );
+      return QPointF( vertex.x(), vertex.y() );
+    }
+};
+
+QFIELDTEST_MAIN( TestQgsQuickMapTransform )
+#include "test_qgsquickmaptransform.moc"
@@ -0,0 +1,147 @@
+/***************************************************************************
+                        test_qgssgtessellator.cpp
+                        --------------------
+  begin                : Oct 2026
+  copyright            : (C) 2026 by QField contributors
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include <QtTest>
+
+#include "qfield_testbase.h"
+
+#include "qgssgtessellator.h"
+
+#include <cmath>
+
+
+class TestQgsSGTessellator: public QObject
+{
+    Q_OBJECT
+  private slots:
+    void testInteriorRings()
+    {
+      const QgsGeometry polygon = QgsGeometry::fromWkt( QStringLiteral( "Polygon ((0 0, 10 0, 10 10, 0 10, 0 0), (4 4, 6 4, 6 6, 4 6, 4 4))" ) );
+      const QVector<QgsPointXY> triangles = QgsSGTessellator::tessellate( polygon );
+      QCOMPARE( triangles.size() % 3, 0 );
+
+      // The hole is not covered by any triangle
+      QCOMPARE( area( triangles ), 96.0 );
+      QVERIFY( !covers( triangles, QgsPointXY( 5, 5 ) ) );
+      QVERIFY( covers( triangles, QgsPointXY( 2, 2 ) ) );
+    }
+
+    void testMultiPolygon()
+    {
+      const QgsGeometry multiPolygon = QgsGeometry::fromWkt( QStringLiteral( "MultiPolygon (((0 0, 10 0, 10 10, 0 10, 0 0), (4 4, 6 4, 6 6, 4 6, 4 4)), ((20 0, 22 0, 22 2, 20 0)))" ) );
+      const QVector<QgsPointXY> triangles = QgsSGTessellator::tessellate( multiPolygon );
+      QCOMPARE( area( triangles ), 98.0 );
+      QVERIFY( covers( triangles, QgsPointXY( 21.5, 0.5 ) ) );
+    }
+
+    void testCache()
+    {
+      QgsSGTessellator tessellator;
+      const QgsCoordinateReferenceSystem lv95( QStringLiteral( "EPSG:2056" ) );
+      const QgsCoordinateReferenceSystem wgs84( QStringLiteral( "EPSG:4326" ) );
+      const QgsGeometry polygon = QgsGeometry::fromWkt( QStringLiteral( "Polygon ((2600000 1200000, 2600100 1200000, 2600100 1200100, 2600000 1200000))" ) );
+
+      const QgsSGTessellator::Tessellation first = tessellator.tessellation( polygon, lv95, lv95, QgsCoordinateTransformContext() );
+      QCOMPARE( first.triangles.size(), 3 );
+
+      // An equal geometry, e.g. of the same feature fetched again, is a lookup returning the shared triangles
+      const QgsGeometry copy = QgsGeometry::fromWkt( polygon.asWkt() );
+      const QgsSGTessellator::Tessellation second = tessellator.tessellation( copy, lv95, lv95, QgsCoordinateTransformContext() );
+      QCOMPARE( second.triangles.constData(), first.triangles.constData() );
+
+      // Another destination CRS needs its own tessellation
+      const QgsSGTessellator::Tessellation transformed = tessellator.tessellation( polygon, lv95, wgs84, QgsCoordinateTransformContext() );
+      QVERIFY( transformed.triangles.constData() != first.triangles.constData() );
+      QVERIFY( transformed.geometry.boundingBox().xMinimum() < 180 );
+
+      // Datum transforms of another transform context may move the geometry
+      QgsCoordinateTransformContext context;
+      context.addCoordinateOperation( lv95, wgs84, QStringLiteral( "+proj=noop" ) );
+      const QgsSGTessellator::Tessellation otherContext = tessellator.tessellation( polygon, lv95, wgs84, context );
+      QVERIFY( otherContext.triangles.constData() != transformed.triangles.constData() );
+
+      tessellator.clear();
+      const QgsSGTessellator::Tessellation third = tessellator.tessellation( polygon, lv95, lv95, QgsCoordinateTransformContext() );
+      QVERIFY( third.triangles.constData() != first.triangles.constData() );
+    }
+
+    void testLevelOfDetail()
+    {
+      // Scales within a factor of two share their level
+      QCOMPARE( QgsSGTessellator::levelOfDetail( 1.0 ), 0 );
+      QCOMPARE( QgsSGTessellator::levelOfDetail( 1.9 ), 0 );
+      QCOMPARE( QgsSGTessellator::levelOfDetail( 2.0 ), 1 );
+      QCOMPARE( QgsSGTessellator::levelOfDetail( 0.3 ), -2 );
+      QCOMPARE( QgsSGTessellator::levelOfDetail( 0.0 ), QgsSGTessellator::FullDetail );
+      QCOMPARE( QgsSGTessellator::simplificationTolerance( 1 ), 1.0 );
+
+      // A line zigzagging by 1 cm every meter
+      QgsPolylineXY points;
+      for ( int i = 0; i <= 10000; ++i )
+        points << QgsPointXY( 2600000 + i, 1200000 + ( i % 2 ) * 0.01 );
+      const QgsGeometry line = QgsGeometry::fromPolylineXY( points );
+
+      QgsSGTessellator tessellator;
+      const QgsCoordinateReferenceSystem lv95( QStringLiteral( "EPSG:2056" ) );
+
+      const QgsSGTessellator::Tessellation full = tessellator.tessellation( line, lv95, lv95, QgsCoordinateTransformContext() );
+      QCOMPARE( full.geometry.constGet()->nCoordinates(), 10001 );
+
+      // Zoomed out to 10 m per point, the zigzag is not visible anymore
+      const int level = QgsSGTessellator::levelOfDetail( 10 );
+      const QgsSGTessellator::Tessellation simplified = tessellator.tessellation( line, lv95, lv95, QgsCoordinateTransformContext(), level );
+      QCOMPARE( simplified.geometry.constGet()->nCoordinates(), 2 );
+      QCOMPARE( simplified.geometry.boundingBox().width(), 10000.0 );
+
+      // Each level is cached separately
+      const QgsSGTessellator::Tessellation cached = tessellator.tessellation( line, lv95, lv95, QgsCoordinateTransformContext(), level );
+      QVERIFY( cached.geometry.constGet() == simplified.geometry.constGet() );
+
+      // Zoomed in to 1 mm per point, all vertices are kept
+      const QgsSGTessellator::Tessellation detailed = tessellator.tessellation( line, lv95, lv95, QgsCoordinateTransformContext(), QgsSGTessellator::levelOfDetail( 0.001 ) );
+      QCOMPARE( detailed.geometry.constGet()->nCoordinates(), 10001 );
+    }
+
+  private:
+    static double area( const QVector<QgsPointXY> &triangles )
+    {
+      double area = 0;
+      for ( int i = 0; i + 2 < triangles.size(); i += 3 )
+        area += std::fabs( cross( triangles.at( i ), triangles.at( i + 1 ), triangles.at( i + 2 ) ) ) / 2;
+      return area;
+    }
+
+    static bool covers( const QVector<QgsPointXY> &triangles, const QgsPointXY &point )
+    {
+      for ( int i = 0; i + 2 < triangles.size(); i += 3 )
+      {
+        const double d1 = cross( triangles.at( i ), triangles.at( i + 1 ), point );
+        const double d2 = cross( triangles.at( i + 1 ), triangles.at( i + 2 ), point );
+        const double d3 = cross( triangles.at( i + 2 ), triangles.at( i ), point );
+        if ( ( d1 >= 0 && d2 >= 0 && d3 >= 0 ) || ( d1 <= 0 && d2 <= 0 && d3 <= 0 ) )
+          return true;
+      }
+      return false;
+    }
+
+    static double cross( const QgsPointXY &a, const QgsPointXY &b, const QgsPointXY &c )
+    {
+      return ( b.x() - a.x() ) * ( c.y() - a.y() ) - ( b.y() - a.y() ) * ( c.x() - a.x() );
+    }
+};
+
+QFIELDTEST_MAIN( TestQgsSGTessellator )
+#include "test_qgssgtessellator.moc"
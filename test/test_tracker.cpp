@@ -0,0 +1,183 @@
+/***************************************************************************
+                        test_tracker.cpp
+                        --------------------
+  begin                : Oct 2026
+  copyright            : (C) 2026 by QField contributors
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include <QtTest>
+
+#include "qfield_testbase.h"
+
+#include "rubberbandmodel.h"
+#include "tracker.h"
+
+#include <qgsproject.h>
+#include <qgsvectordataprovider.h>
+#include <qgsvectorlayer.h>
+
+
+class TestTracker: public QObject
+{
+    Q_OBJECT
+  private slots:
+    void initTestCase()
+    {
+      const QgsCoordinateReferenceSystem lv95( QStringLiteral( "EPSG:2056" ) );
+      QgsProject::instance()->setCrs( lv95 );
+      QgsProject::instance()->setEllipsoid( QStringLiteral( "EPSG:7004" ) );
+
+      mLayer = std::unique_ptr<QgsVectorLayer>( new QgsVectorLayer( QStringLiteral( "LineString?crs=epsg:2056" ), QStringLiteral( "tracks" ), QStringLiteral( "memory" ) ) );
+      mModel = std::unique_ptr<RubberbandModel>( new RubberbandModel() );
+      mModel->setCrs( lv95 );
+    }
+
+    void cleanup()
+    {
+      mModel->reset();
+    }
+
+    void testMinimumDistance()
+    {
+      Tracker tracker( mLayer.get(), true );
+      tracker.setModel( mModel.get() );
+      tracker.setMinimumDistance( 5 );
+      tracker.setConjunction( false );
+
+      mModel->setCurrentCoordinate( QgsPoint( 2600000, 1200000 ) );
+      tracker.start();
+      QCOMPARE( mModel->vertexCount(), 2 );
+
+      // A vertex every 6 m, the first position further than 5 m from the last one
+      for ( int i = 1; i <= 60; ++i )
+        mModel->setCurrentCoordinate( QgsPoint( 2600000 + i, 1200000 ) );
+
+      QCOMPARE( mModel->vertexCount(), 12 );
+      QVERIFY( qgsDoubleNear( tracker.length(), 60, 0.1 ) );
+
+      tracker.stop();
+    }
+
+    void testStreaming()
+    {
+      Tracker tracker( mLayer.get(), true );
+      tracker.setModel( mModel.get() );
+      tracker.setMinimumDistance( 5 );
+      tracker.setConjunction( false );
+
+      mModel->setCurrentCoordinate( QgsPoint( 2600000, 1200000 ) );
+      tracker.start();
+
+      // The feature is created from the first vertex, as done by the tracking view
+      QgsFeature feature( mLayer->fields() );
+      feature.setGeometry( QgsGeometry::fromPolyline( QgsPolyline() << QgsPoint( 2600000, 1200000 ) << QgsPoint( 2600000, 1200000 ) ) );
+      QgsFeatureList features = QgsFeatureList() << feature;
+      QVERIFY( mLayer->dataProvider()->addFeatures( features ) );
+      feature = features.first();
+      tracker.setFeature( feature );
+
+      for ( int i = 1; i <= 500; ++i )
+      {
+        mModel->setCurrentCoordinate( QgsPoint( 2600000 + i * 6, 1200000 ) );
+
+        // The vertices not yet written are kept in the rubberband along with the display window
+        QVERIFY( mModel->vertexCount() <= Tracker::DISPLAY_WINDOW_SIZE + Tracker::PERSIST_BATCH_SIZE + 1 );
+      }
+
+      // Written in batches while tracking, after the two vertices the feature was created with
+      QgsFeature stored = mLayer->getFeature( feature.id() );
+      QCOMPARE( stored.geometry().constGet()->nCoordinates(), 2 + 500 / Tracker::PERSIST_BATCH_SIZE * Tracker::PERSIST_BATCH_SIZE );
+
+      // The rest is written when tracking stops
+      mModel->setCurrentCoordinate( QgsPoint( 2600000 + 501 * 6, 1200000 ) );
+      tracker.stop();
+      stored = mLayer->getFeature( feature.id() );
+      QCOMPARE( stored.geometry().constGet()->nCoordinates(), 503 );
+      QCOMPARE( stored.geometry().length(), 501 * 6.0 );
+      QCOMPARE( mModel->currentCoordinate(), QgsPoint( 2600000 + 501 * 6, 1200000 ) );
+    }
+
+    void testSimplification()
+    {
+      Tracker tracker( mLayer.get(), true );
+      tracker.setModel( mModel.get() );
+      tracker.setMinimumDistance( 1 );
+      tracker.setConjunction( false );
+      tracker.setSimplificationTolerance( 0.5 );
+
+      mModel->setCurrentCoordinate( QgsPoint( 2600000, 1200000 ) );
+      tracker.start();
+
+      QgsFeature feature( mLayer->fields() );
+      feature.setGeometry( QgsGeometry::fromPolyline( QgsPolyline() << QgsPoint( 2600000, 1200000 ) << QgsPoint( 2600000, 1200000 ) ) );
+      QgsFeatureList features = QgsFeatureList() << feature;
+      QVERIFY( mLayer->dataProvider()->addFeatures( features ) );
+      feature = features.first();
+      tracker.setFeature( feature );
+
+      // A straight path with 20 cm of jitter is a single segment
+      QVector<QgsPointXY> positions;
+      for ( int i = 1; i <= 60; ++i )
+      {
+        positions << QgsPointXY( 2600000 + i * 1.5, 1200000 + ( i % 2 ) * 0.2 );
+        mModel->setCurrentCoordinate( QgsPoint( positions.last() ) );
+      }
+      QCOMPARE( mModel->vertexCount(), 3 );
+
+      // Turning fixes the corner
+      for ( int i = 1; i <= 60; ++i )
+      {
+        positions << QgsPointXY( 2600090, 1200000 + i * 1.5 );
+        mModel->setCurrentCoordinate( QgsPoint( positions.last() ) );
+      }
+      QCOMPARE( mModel->vertexCount(), 4 );
+
+      tracker.stop();
+
+      const QgsGeometry stored = mLayer->getFeature( feature.id() ).geometry();
+      QCOMPARE( stored.constGet()->nCoordinates(), 4 );
+      for ( const QgsPointXY &position : qgis::as_const( positions ) )
+        QVERIFY( stored.distance( QgsGeometry::fromPointXY( position ) ) <= 0.5 );
+    }
+
+    void benchmarkLongTrack()
+    {
+      Tracker tracker( mLayer.get(), true );
+      tracker.setModel( mModel.get() );
+      tracker.setMinimumDistance( 5 );
+      tracker.setConjunction( false );
+
+      // Two hours at 1 Hz
+      mModel->setCurrentCoordinate( QgsPoint( 2600000, 1200000 ) );
+      tracker.start();
+      for ( int i = 1; i <= 7200; ++i )
+        mModel->setCurrentCoordinate( QgsPoint( 2600000 + i * 6, 1200000 ) );
+      QCOMPARE( mModel->vertexCount(), 7202 );
+
+      // Positions within the minimum distance of the last vertex
+      int fix = 0;
+      QBENCHMARK
+      {
+        mModel->setCurrentCoordinate( QgsPoint( 2600000 + 7200 * 6, 1200000 + ( ++fix % 2 ) ) );
+      }
+      QCOMPARE( mModel->vertexCount(), 7202 );
+
+      tracker.stop();
+    }
+
+  private:
+    std::unique_ptr<QgsVectorLayer> mLayer;
+    std::unique_ptr<RubberbandModel> mModel;
+};
+
+QFIELDTEST_MAIN( TestTracker )
+#include "test_tracker.moc"